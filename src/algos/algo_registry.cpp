@@ -0,0 +1,495 @@
+#include "algo_registry.hpp"
+#include "algo_utils.hpp"
+
+#include <stdexcept> // For throwing stuff
+
+
+AlgoFamily::AlgoFamily(const std::string& pattern, bool multi_bin, const AlgoCreator& create):
+    pattern(pattern),
+    multi_bin(multi_bin),
+    creator(create)
+{
+    // The optional variants are written "[-Dyn]" in the patterns, so that the pattern reads
+    // like the names: move the bracket after the dash before splitting
+    std::string s = pattern;
+    size_t pos;
+    while ((pos = s.find("[-")) != std::string::npos)
+    {
+        s.replace(pos, 2, "-[");
+    }
+    tokens = splitString(s);
+}
+
+const std::string& AlgoFamily::getPattern() const
+{
+    return pattern;
+}
+
+bool AlgoFamily::isMultiBin() const
+{
+    return multi_bin;
+}
+
+bool AlgoFamily::parse(const std::vector<std::string>& name_tokens, AlgoSpec& spec) const
+{
+    spec = {MEASURE::LINF, SCORE::DOT_PRODUCT1, WEIGHT::UNIT, WEIGHT::UNIT, false, false, 0};
+    return parseFrom(name_tokens, 0, 0, spec);
+}
+
+static bool parsePositiveInt(const std::string& s, int& value)
+{
+    if (s.empty() || (s.size() > 9) || (s.find_first_not_of("0123456789") != std::string::npos))
+    {
+        return false;
+    }
+    value = std::stoi(s);
+    return (value > 0);
+}
+
+bool AlgoFamily::parseFrom(const std::vector<std::string>& name_tokens, size_t name_index, size_t token_index, AlgoSpec& spec) const
+{
+    if (token_index == tokens.size())
+    {
+        return (name_index == name_tokens.size());
+    }
+
+    const std::string& token = tokens[token_index];
+    if ((token == "[Dyn]") || (token == "[Dyn|Bin]"))
+    {
+        // Optional variant: first try with it, then without it
+        if (name_index < name_tokens.size())
+        {
+            const std::string& s = name_tokens[name_index];
+            if ((s == "Dyn") || ((s == "Bin") && (token == "[Dyn|Bin]")))
+            {
+                spec.dynamic = true;
+                spec.bin_weights = (s == "Bin");
+                if (parseFrom(name_tokens, name_index + 1, token_index + 1, spec))
+                {
+                    return true;
+                }
+                spec.dynamic = false;
+                spec.bin_weights = false;
+            }
+        }
+        return parseFrom(name_tokens, name_index, token_index + 1, spec);
+    }
+
+    if (name_index == name_tokens.size())
+    {
+        return false;
+    }
+    const std::string& s = name_tokens[name_index];
+    if (token == "<measure>")
+    {
+        auto it = map_str_to_measure.find(s);
+        if (it == map_str_to_measure.end())
+        {
+            return false;
+        }
+        spec.measure = it->second;
+    }
+    else if ((token == "<weight>") || (token == "<bin_weight>"))
+    {
+        auto it = map_str_to_weight.find(s);
+        if (it == map_str_to_weight.end())
+        {
+            return false;
+        }
+        (token == "<weight>" ? spec.weight : spec.bin_weight) = it->second;
+    }
+    else if (token == "<score>")
+    {
+        auto it = map_str_to_score.find(s);
+        if (it == map_str_to_score.end())
+        {
+            return false;
+        }
+        spec.score = it->second;
+    }
+    else if (token == "<n>")
+    {
+        if (!parsePositiveInt(s, spec.nb_increment))
+        {
+            return false;
+        }
+    }
+    else if (token != s)
+    {
+        return false; // Literal
+    }
+    return parseFrom(name_tokens, name_index + 1, token_index + 1, spec);
+}
+
+void AlgoFamily::listNames(std::vector<std::string>& names) const
+{
+    listFrom(0, "", names);
+}
+
+void AlgoFamily::listFrom(size_t token_index, const std::string& prefix, std::vector<std::string>& names) const
+{
+    if (token_index == tokens.size())
+    {
+        names.push_back(prefix);
+        return;
+    }
+
+    const std::string& token = tokens[token_index];
+    std::vector<std::string> values;
+    if (token == "<measure>")
+    {
+        for (const auto& measure : map_str_to_measure)
+        {
+            values.push_back(measure.first);
+        }
+    }
+    else if ((token == "<weight>") || (token == "<bin_weight>"))
+    {
+        for (const auto& weight : map_str_to_weight)
+        {
+            values.push_back(weight.first);
+        }
+    }
+    else if (token == "<score>")
+    {
+        for (const auto& score : map_str_to_score)
+        {
+            values.push_back(score.first);
+        }
+    }
+    else if (token == "<n>")
+    {
+        for (int n : registry_increments)
+        {
+            values.push_back(std::to_string(n));
+        }
+    }
+    else if (token == "[Dyn]")
+    {
+        values = {"", "Dyn"}; // Empty for the variant without the token
+    }
+    else if (token == "[Dyn|Bin]")
+    {
+        values = {"", "Dyn", "Bin"};
+    }
+    else
+    {
+        values.push_back(token);
+    }
+
+    for (const std::string& value : values)
+    {
+        if (value.empty())
+        {
+            listFrom(token_index + 1, prefix, names);
+        }
+        else
+        {
+            listFrom(token_index + 1, (prefix.empty() ? value : prefix + "-" + value), names);
+        }
+    }
+}
+
+BaseAlgo* AlgoFamily::create(const std::string& algo_name, const AlgoSpec& spec, const Instance& instance) const
+{
+    return creator(algo_name, spec, instance);
+}
+
+
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+// Instantiations of the engines of the measure-based and score-based algorithms
+// dynamic must be the flag of dynamic weights the constructor will set
+// The one- and two-dimensional engines replace the general ones on such instances, for static weights
+template<class Base, MEASURE M, typename... Args>
+static BaseAlgo* createFitEngineFlag(bool dynamic, int dimensions, const Args&... args)
+{
+    if (dynamic)
+    {
+        return new AlgoFitEngine<Base, M, true>(args...);
+    }
+    if constexpr (hasOneDimEngine<Base>())
+    {
+        if (dimensions == 1)
+        {
+            return new AlgoFitEngine1D<Base, M>(args...);
+        }
+    }
+    if constexpr (hasTwoDimEngine<Base>())
+    {
+        if (dimensions == 2)
+        {
+            return new AlgoFitEngine2D<Base, M>(args...);
+        }
+    }
+    return new AlgoFitEngine<Base, M, false>(args...);
+}
+
+template<class Base, typename... Args>
+static BaseAlgo* createFitEngine(MEASURE measure, bool dynamic, const Instance& instance, const Args&... args)
+{
+    int dimensions = instance.getDimensions();
+    switch(measure)
+    {
+    case MEASURE::LINF:
+        return createFitEngineFlag<Base, MEASURE::LINF>(dynamic, dimensions, args...);
+    case MEASURE::L1:
+        return createFitEngineFlag<Base, MEASURE::L1>(dynamic, dimensions, args...);
+    case MEASURE::L2:
+        return createFitEngineFlag<Base, MEASURE::L2>(dynamic, dimensions, args...);
+    case MEASURE::L2_LOAD:
+        return createFitEngineFlag<Base, MEASURE::L2_LOAD>(dynamic, dimensions, args...);
+    }
+    throw std::runtime_error("Unknown measure");
+}
+
+template<SCORE S, typename... Args>
+static BaseAlgo* createBinCentricEngineFlag(bool dynamic, const Args&... args)
+{
+    if (dynamic)
+    {
+        return new AlgoBinCentricEngine<S, true>(args...);
+    }
+    return new AlgoBinCentricEngine<S, false>(args...);
+}
+
+template<typename... Args>
+static BaseAlgo* createBinCentricEngine(SCORE score, bool dynamic, const Args&... args)
+{
+    switch(score)
+    {
+    case SCORE::DOT_PRODUCT1:
+        return createBinCentricEngineFlag<SCORE::DOT_PRODUCT1>(dynamic, args...);
+    case SCORE::DOT_PRODUCT2:
+        return createBinCentricEngineFlag<SCORE::DOT_PRODUCT2>(dynamic, args...);
+    case SCORE::DOT_PRODUCT3:
+        return createBinCentricEngineFlag<SCORE::DOT_PRODUCT3>(dynamic, args...);
+    case SCORE::NORM_DOT_PRODUCT:
+        return createBinCentricEngineFlag<SCORE::NORM_DOT_PRODUCT>(dynamic, args...);
+    case SCORE::L2NORM:
+        return createBinCentricEngineFlag<SCORE::L2NORM>(dynamic, args...);
+    case SCORE::TIGHT_FILL_SUM:
+        return createBinCentricEngineFlag<SCORE::TIGHT_FILL_SUM>(dynamic, args...);
+    case SCORE::TIGHT_FILL_MIN:
+        return createBinCentricEngineFlag<SCORE::TIGHT_FILL_MIN>(dynamic, args...);
+    }
+    throw std::runtime_error("Unknown score");
+}
+
+// Ratio weights are always dynamic
+static bool isDynamic(const AlgoSpec& spec)
+{
+    return spec.dynamic || (spec.weight == WEIGHT::UTILIZATION_RATIO);
+}
+
+// Creators of the families with the same parameters
+template<class Algo>
+static AlgoCreator fitCreator()
+{
+    // The dynamic flag of the constructor is also set for ratio weights
+    return [](const std::string& algo_name, const AlgoSpec& spec, const Instance& instance) {
+        return createFitEngine<Algo>(spec.measure, isDynamic(spec), instance, algo_name, instance, spec.measure, spec.weight, isDynamic(spec));
+    };
+}
+
+template<class Algo>
+static AlgoCreator fitT2Creator()
+{
+    // The constructor of AlgoFFD sets the dynamic flag for ratio weights
+    return [](const std::string& algo_name, const AlgoSpec& spec, const Instance& instance) {
+        return createFitEngine<Algo>(spec.measure, isDynamic(spec), instance, algo_name, instance, spec.measure, spec.weight, spec.dynamic);
+    };
+}
+
+template<class Algo>
+static AlgoCreator fitT3Creator()
+{
+    return [](const std::string& algo_name, const AlgoSpec& spec, const Instance& instance) {
+        return createFitEngine<Algo>(spec.measure, isDynamic(spec), instance, algo_name, instance, spec.measure, spec.weight, spec.bin_weight, spec.dynamic);
+    };
+}
+
+template<class Algo>
+static AlgoCreator fitStaticCreator()
+{
+    return [](const std::string& algo_name, const AlgoSpec& spec, const Instance& instance) {
+        return createFitEngine<Algo>(spec.measure, isDynamic(spec), instance, algo_name, instance, spec.measure, spec.weight);
+    };
+}
+
+// Algo1D on one-dimensional instances
+template<class Algo, class Algo1D>
+static AlgoCreator oneDimCreator()
+{
+    return [](const std::string& algo_name, const AlgoSpec&, const Instance& instance) -> BaseAlgo* {
+        if (instance.getDimensions() == 1)
+        {
+            return new Algo1D(algo_name, instance);
+        }
+        return new Algo(algo_name, instance);
+    };
+}
+
+template<class Algo>
+static AlgoCreator simpleCreator()
+{
+    return [](const std::string& algo_name, const AlgoSpec&, const Instance& instance) {
+        return new Algo(algo_name, instance);
+    };
+}
+
+template<class Algo>
+static AlgoCreator rankCreator()
+{
+    return [](const std::string& algo_name, const AlgoSpec& spec, const Instance& instance) {
+        return new Algo(algo_name, instance, spec.dynamic);
+    };
+}
+
+template<class Algo>
+static AlgoCreator pairingCreator()
+{
+    return [](const std::string& algo_name, const AlgoSpec& spec, const Instance& instance) {
+        return new Algo(algo_name, instance, spec.score, spec.weight, isDynamic(spec), spec.bin_weights);
+    };
+}
+
+template<class Algo>
+static AlgoCreator pairingIncrementCreator()
+{
+    return [](const std::string& algo_name, const AlgoSpec& spec, const Instance& instance) {
+        return new Algo(algo_name, instance, spec.score, spec.weight, isDynamic(spec), spec.bin_weights, spec.nb_increment);
+    };
+}
+
+template<class Algo>
+static AlgoCreator multiBinCreator()
+{
+    return [](const std::string& algo_name, const AlgoSpec& spec, const Instance& instance) {
+        return new Algo(algo_name, instance, spec.measure, spec.weight, isDynamic(spec));
+    };
+}
+
+template<class Algo>
+static AlgoCreator multiBinIncrementCreator()
+{
+    return [](const std::string& algo_name, const AlgoSpec& spec, const Instance& instance) {
+        return new Algo(algo_name, instance, spec.measure, spec.weight, isDynamic(spec), spec.nb_increment);
+    };
+}
+
+const std::vector<AlgoFamily>& getAlgoFamilies()
+{
+    static const std::vector<AlgoFamily> families = {
+        // Item-centric algos
+        {"FF", false, oneDimCreator<AlgoFF, AlgoFF_1D>()},
+        {"FFD-Lexico", false, simpleCreator<AlgoFFD_Lexico>()},
+        {"BFD-Lexico", false, simpleCreator<AlgoBFD_Lexico>()},
+        {"WFD-Lexico", false, simpleCreator<AlgoWFD_Lexico>()},
+        {"FFD-Rank[-Dyn]", false, rankCreator<AlgoFFD_Rank>()},
+        {"BFD-Rank[-Dyn]", false, rankCreator<AlgoBFD_Rank>()},
+        {"WFD-Rank[-Dyn]", false, rankCreator<AlgoWFD_Rank>()},
+        {"FFD-<measure>-<weight>[-Dyn]", false, fitCreator<AlgoFFD>()},
+        {"BFD-T1-<measure>-<weight>[-Dyn]", false, fitCreator<AlgoBFD_T1>()},
+        {"BFD-T2-<measure>-<weight>[-Dyn]", false, fitT2Creator<AlgoBFD_T2>()},
+        {"BFD-T3-<measure>-<weight>-<bin_weight>[-Dyn]", false, fitT3Creator<AlgoBFD_T3>()},
+        {"BF-<measure>-<weight>", false, fitStaticCreator<AlgoBF>()},
+        {"WFD-T1-<measure>-<weight>[-Dyn]", false, fitCreator<AlgoWFD_T1>()},
+        {"WFD-T2-<measure>-<weight>[-Dyn]", false, fitT2Creator<AlgoWFD_T2>()},
+        {"WFD-T3-<measure>-<weight>-<bin_weight>[-Dyn]", false, fitT3Creator<AlgoWFD_T3>()},
+        {"WF-<measure>-<weight>", false, fitStaticCreator<AlgoWF>()},
+        // Bin-centric with Score algos
+        {"BCS-<score>-<weight>[-Dyn|Bin]", false,
+            [](const std::string& algo_name, const AlgoSpec& spec, const Instance& instance) {
+                return createBinCentricEngine(spec.score, isDynamic(spec),
+                                              algo_name, instance, spec.score, spec.weight,
+                                              isDynamic(spec), spec.bin_weights);
+            }},
+        // Multi-bin algos
+        {"Pairing-BS-<score>-<weight>[-Dyn|Bin]", true, pairingCreator<AlgoPairing_BinSearch>()},
+        {"Pairing-Incr-<score>-<weight>[-Dyn|Bin]-<n>", true, pairingIncrementCreator<AlgoPairing_Increment>()},
+        {"WFDm-BS-<measure>-<weight>[-Dyn]", true, multiBinCreator<AlgoWFDm_BinSearch>()},
+        {"WFDm-Incr-<measure>-<weight>[-Dyn]-<n>", true, multiBinIncrementCreator<AlgoWFDm_Increment>()},
+        {"BFDm-BS-<measure>-<weight>[-Dyn]", true, multiBinCreator<AlgoBFDm_BinSearch>()},
+        {"BFDm-Incr-<measure>-<weight>[-Dyn]-<n>", true, multiBinIncrementCreator<AlgoBFDm_Increment>()},
+    };
+    return families;
+}
+
+const AlgoFamily* findAlgoFamily(const std::string& algo_name, AlgoSpec& spec)
+{
+    std::vector<std::string> name_tokens = splitString(algo_name);
+    for (const AlgoFamily& family : getAlgoFamilies())
+    {
+        if (family.parse(name_tokens, spec))
+        {
+            return &family;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::string> listAlgoNames()
+{
+    std::vector<std::string> names;
+    for (const AlgoFamily& family : getAlgoFamilies())
+    {
+        family.listNames(names);
+    }
+    return names;
+}
+
+std::vector<std::string> expandAlgoNames(const std::vector<std::string>& selection)
+{
+    std::vector<std::string> all_names; // Only listed if needed
+    std::vector<std::string> names;
+    for (const std::string& name : selection)
+    {
+        if ((name != "all") && (name.empty() || (name.back() != '*')))
+        {
+            names.push_back(name);
+            continue;
+        }
+
+        if (all_names.empty())
+        {
+            all_names = listAlgoNames();
+        }
+        std::string prefix = (name == "all") ? "" : name.substr(0, name.size() - 1);
+        size_t nb_names = names.size();
+        for (const std::string& algo_name : all_names)
+        {
+            if (algo_name.compare(0, prefix.size(), prefix) == 0)
+            {
+                names.push_back(algo_name);
+            }
+        }
+        if (names.size() == nb_names)
+        {
+            std::string s = "No algorithm name matches \'" + name + "\'";
+            throw std::runtime_error(s);
+        }
+    }
+    return names;
+}
+
+std::string unknownAlgoMessage(const std::string& algo_name)
+{
+    std::string message = "Unknown algorithm name \'" + algo_name + "\'";
+    std::vector<std::string> name_tokens = splitString(algo_name);
+    std::string patterns;
+    for (const AlgoFamily& family : getAlgoFamilies())
+    {
+        const std::string& pattern = family.getPattern();
+        if (!name_tokens.empty() && (splitString(pattern)[0] == name_tokens[0]))
+        {
+            patterns += (patterns.empty() ? "" : ", ") + pattern;
+        }
+    }
+    if (!patterns.empty())
+    {
+        message += ", expected " + patterns;
+    }
+    return message;
+}
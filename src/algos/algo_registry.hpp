@@ -0,0 +1,79 @@
+#ifndef ALGO_REGISTRY_HPP
+#define ALGO_REGISTRY_HPP
+
+#include "base_algo.hpp"
+#include "weights_measures_scores.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace vectorpack;
+
+// Parameters of an algorithm, parsed from its name
+// Only the parameters of the family of the algorithm are set
+struct AlgoSpec
+{
+    MEASURE measure;
+    SCORE score;
+    WEIGHT weight;
+    WEIGHT bin_weight;  // For T3 algorithms
+    bool dynamic;       // "Dyn" or "Bin" variant: weights re-computed after each packing
+    bool bin_weights;   // "Bin" variant: weights computed from the bin residual capacities
+    int nb_increment;   // Number of bins added at each step of increment algorithms
+};
+
+// The algorithm keeps a reference on algo_name, which must outlive it
+using AlgoCreator = std::function<BaseAlgo*(const std::string& algo_name, const AlgoSpec& spec, const Instance& instance)>;
+
+// A family of algorithms sharing the same name pattern
+// The pattern is made of tokens separated by '-':
+//  - literals, e.g. "BFD" or "T1"
+//  - parameters: <measure>, <weight>, <bin_weight>, <score> (names of weights_measures_scores.hpp)
+//    or <n> (a positive integer)
+//  - optional variants: [Dyn] or [Dyn|Bin]
+// e.g. "BFD-T1-<measure>-<weight>[-Dyn]" for "BFD-T1-L2-Avg" and "BFD-T1-L2-Avg-Dyn"
+class AlgoFamily
+{
+public:
+    AlgoFamily(const std::string& pattern, bool multi_bin, const AlgoCreator& create);
+
+    const std::string& getPattern() const;
+    bool isMultiBin() const; // To be solved with solveInstanceMultiBin
+
+    bool parse(const std::vector<std::string>& name_tokens, AlgoSpec& spec) const; // False if the name does not match
+    void listNames(std::vector<std::string>& names) const; // Appends all names of the family
+    BaseAlgo* create(const std::string& algo_name, const AlgoSpec& spec, const Instance& instance) const;
+
+protected:
+    bool parseFrom(const std::vector<std::string>& name_tokens, size_t name_index, size_t token_index, AlgoSpec& spec) const;
+    void listFrom(size_t token_index, const std::string& prefix, std::vector<std::string>& names) const;
+
+    const std::string pattern;
+    std::vector<std::string> tokens;
+    const bool multi_bin;
+    const AlgoCreator creator;
+};
+
+// Values of <n> used when enumerating the names of the families
+const static std::vector<int> registry_increments = {1, 5, 10};
+
+// All families of algorithms, in the order of the listing
+const std::vector<AlgoFamily>& getAlgoFamilies();
+
+// Family of the algorithm and its parameters, nullptr if the name is not valid
+const AlgoFamily* findAlgoFamily(const std::string& algo_name, AlgoSpec& spec);
+
+// Every valid algorithm name, with the values of registry_increments for <n>
+std::vector<std::string> listAlgoNames();
+
+// Replace "all" by every valid algorithm name, and a name ending with '*' by the valid names
+// starting with the characters before it (e.g. "BCS-*"), keeping the order of the list
+// Throws if a selection matches no algorithm
+std::vector<std::string> expandAlgoNames(const std::vector<std::string>& selection);
+
+// Error message for an algorithm name which is not valid, with the patterns of the families
+// sharing its first token
+std::string unknownAlgoMessage(const std::string& algo_name);
+
+#endif // ALGO_REGISTRY_HPP
@@ -0,0 +1,84 @@
+#include "algo_stats.hpp"
+
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+// Names and values of all counters, in their order of declaration
+static std::vector<std::pair<std::string, uint64_t>> listCounters(const AlgoStats& stats)
+{
+    return {
+        { "fit_checks", stats.fit_checks },
+        { "fit_failures", stats.fit_failures },
+        { "score_evaluations", stats.score_evaluations },
+        { "items_packed", stats.items_packed },
+        { "bins_scanned", stats.bins_scanned },
+        { "index_nodes", stats.index_nodes },
+        { "sort_calls", stats.sort_calls },
+        { "sort_elements", stats.sort_elements },
+        { "bubble_calls", stats.bubble_calls },
+        { "bubble_swaps", stats.bubble_swaps },
+        { "bins_created", stats.bins_created },
+        { "probes", stats.probes },
+    };
+}
+
+bool AlgoStats::isEnabled()
+{
+#ifdef VECTORPACK_COUNTERS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AlgoStats::merge(const AlgoStats& other)
+{
+    fit_checks += other.fit_checks;
+    fit_failures += other.fit_failures;
+    score_evaluations += other.score_evaluations;
+    items_packed += other.items_packed;
+    bins_scanned += other.bins_scanned;
+    index_nodes += other.index_nodes;
+    sort_calls += other.sort_calls;
+    sort_elements += other.sort_elements;
+    bubble_calls += other.bubble_calls;
+    bubble_swaps += other.bubble_swaps;
+    bins_created += other.bins_created;
+    probes += other.probes;
+}
+
+void AlgoStats::clear()
+{
+    *this = AlgoStats();
+}
+
+std::string AlgoStats::toString() const
+{
+    std::ostringstream ss;
+    for (const auto& counter : listCounters(*this))
+    {
+        ss << counter.first << ": " << counter.second << "\n";
+    }
+    if ((items_packed > 0) && (bins_scanned > 0))
+    {
+        ss << std::fixed << std::setprecision(2)
+           << "bins_scanned_per_item: " << (double)bins_scanned / items_packed << "\n";
+    }
+    return ss.str();
+}
+
+std::string AlgoStats::toJson() const
+{
+    std::ostringstream ss;
+    ss << "{";
+    bool first = true;
+    for (const auto& counter : listCounters(*this))
+    {
+        ss << (first ? "" : ", ") << "\"" << counter.first << "\": " << counter.second;
+        first = false;
+    }
+    ss << "}";
+    return ss.str();
+}
@@ -0,0 +1,42 @@
+#ifndef ALGO_STATS_HPP
+#define ALGO_STATS_HPP
+
+#include <cstdint>
+#include <string>
+
+// Counters of the operations performed in the hot paths of the algorithms
+// They are only updated when the library is built with VECTORPACK_COUNTERS defined
+// (cmake option 'enable_counters'), otherwise all counters stay at 0
+struct AlgoStats
+{
+    uint64_t fit_checks = 0;        // Number of calls to Bin::doesItemFit
+    uint64_t fit_failures = 0;      // Number of these calls where the item did not fit
+    uint64_t score_evaluations = 0; // Number of item-bin scores computed
+    uint64_t items_packed = 0;      // Number of items added to a bin
+    uint64_t bins_scanned = 0;      // Number of bins visited while searching a bin for an item
+    uint64_t index_nodes = 0;       // Number of nodes visited in the indexes of bins of the 1-D and 2-D engines
+    uint64_t sort_calls = 0;        // Number of full sorts of items or bins
+    uint64_t sort_elements = 0;     // Total number of elements in these sorts
+    uint64_t bubble_calls = 0;      // Number of rounds of bubble sort
+    uint64_t bubble_swaps = 0;      // Total number of elements swapped in these rounds
+    uint64_t bins_created = 0;      // Number of bins opened (including re-used bins)
+    uint64_t probes = 0;            // Number of calls to trySolve (multi-bin algorithms only)
+
+    static bool isEnabled(); // Whether the counters are compiled in the library
+
+    void merge(const AlgoStats& other); // Add all counters of other to this one
+    void clear();
+
+    std::string toString() const;
+    std::string toJson() const;
+};
+
+// Update a counter, compiled out unless VECTORPACK_COUNTERS is defined
+// The value is not evaluated when counters are disabled
+#ifdef VECTORPACK_COUNTERS
+#define VP_COUNT(counter, value) ((counter) += (value))
+#else
+#define VP_COUNT(counter, value) ((void)sizeof(value))
+#endif
+
+#endif // ALGO_STATS_HPP
@@ -1,6 +1,7 @@
 #include "algo_utils.hpp"
 #include "weights_measures_scores.hpp"
 
+#include <algorithm> // For find
 #include <sstream>
 #include <stdexcept> // For throwing stuff
 
@@ -26,424 +27,129 @@ bool isRatioWeight(const std::string& str)
     return false;
 }
 
-BaseAlgo* createAlgoCentric(const std::string &algo_name, const Instance &instance)
+// Creation through the registry, for the creators of one kind of algorithms
+// first_tokens: first tokens of the patterns of the families of that kind, all families if empty
+static BaseAlgo* createAlgoOfKind(const std::string& algo_name, const Instance &instance,
+                                  const std::string& kind, bool multi_bin,
+                                  const std::vector<std::string>& first_tokens)
 {
-    std::vector<std::string> v = splitString(algo_name);
-    const std::string& s = v[0];
-
-    try {
-        // Item-centric algos
-        if ((s == "FF") && (v.size() == 1))
-        {
-            return new AlgoFF(algo_name, instance);
-        }
-        else if ((v.size() == 2) && (v[1] == "Lexico")) // Lexicographic order
-        {
-            if(s == "FFD")
-            {
-                return new AlgoFFD_Lexico(algo_name, instance);
-            }
-            else if(s == "BFD")
-            {
-                return new AlgoBFD_Lexico(algo_name, instance);
-            }
-            if(s == "WFD")
-            {
-                return new AlgoWFD_Lexico(algo_name, instance);
-            }
-        }
-        else if ((v.size() == 2) && (v[1] == "Rank")) // Aggregated Rank order
-        {
-            if(s == "FFD")
-            {
-                return new AlgoFFD_Rank(algo_name, instance, false);
-            }
-            else if(s == "BFD")
-            {
-                return new AlgoBFD_Rank(algo_name, instance, false);
-            }
-            else if(s == "WFD")
-            {
-                return new AlgoWFD_Rank(algo_name, instance, false);
-            }
-        }
-        else if ((v.size() == 3) && (v[1] == "Rank") && (v[2] == "Dyn")) // Aggregated Rank order
-        {
-            if(s == "FFD")
-            {
-                return new AlgoFFD_Rank(algo_name, instance, true);
-            }
-            else if(s == "BFD")
-            {
-                return new AlgoBFD_Rank(algo_name, instance, true);
-            }
-            else if(s == "WFD")
-            {
-                return new AlgoWFD_Rank(algo_name, instance, true);
-            }
-        }
-        else if (s == "FFD")
-        {
-            if (v.size() == 3)
-            {
-                // FFD with static weights
-                return new AlgoFFD(algo_name, instance,
-                                   map_str_to_measure.at(v[1]),
-                                   map_str_to_weight.at(v[2]),
-                                   isRatioWeight(v[2]));
-            }
-            else if ((v.size() == 4) && (v[3] == "Dyn"))
-            {
-                // FFD with dynamic weights
-                return new AlgoFFD(algo_name, instance,
-                                   map_str_to_measure.at(v[1]),
-                                   map_str_to_weight.at(v[2]),
-                                   true);
-            }
-        }
-        else if (s == "BFD")
-        {
-            if (v[1] == "T1")
-            {
-                if (v.size() == 4)
-                {
-                    // BFD Type 1 with static item weights
-                    return new AlgoBFD_T1(algo_name, instance,
-                                          map_str_to_measure.at(v[2]),
-                                          map_str_to_weight.at(v[3]),
-                                          isRatioWeight(v[3]));
-                }
-                else if ((v.size() == 5) && (v[4] == "Dyn"))
-                {
-                    // BFD Type 1 with dynamic item weights
-                    return new AlgoBFD_T1(algo_name, instance,
-                                          map_str_to_measure.at(v[2]),
-                                          map_str_to_weight.at(v[3]),
-                                          true);
-                }
-            }
-            else if (v[1] == "T2")
-            {
-                if (v.size() == 4)
-                {
-                    return new AlgoBFD_T2(algo_name, instance,
-                                          map_str_to_measure.at(v[2]),
-                                          map_str_to_weight.at(v[3]),
-                                          false);
-                }
-                else if ((v.size() == 5) && (v[4] == "Dyn"))
-                {
-                    return new AlgoBFD_T2(algo_name, instance,
-                                          map_str_to_measure.at(v[2]),
-                                          map_str_to_weight.at(v[3]),
-                                          true);
-                }
-            }
-            else if (v[1] == "T3")
-            {
-                if (v.size() == 5)
-                {
-                    return new AlgoBFD_T3(algo_name, instance,
-                                          map_str_to_measure.at(v[2]),
-                                          map_str_to_weight.at(v[3]),
-                                          map_str_to_weight.at(v[4]),
-                                          false);
-                }
-                else if ((v.size() == 6) && (v[5] == "Dyn"))
-                {
-                    return new AlgoBFD_T3(algo_name, instance,
-                                          map_str_to_measure.at(v[2]),
-                                          map_str_to_weight.at(v[3]),
-                                          map_str_to_weight.at(v[4]),
-                                          true);
-                }
-            }
-        }
-        else if (s=="BF")
-        {
-            if (v.size() == 3)
-            {
-                return new AlgoBF(algo_name, instance,
-                                     map_str_to_measure.at(v[1]),
-                                     map_str_to_weight.at(v[2]));
-            }
-        }
-        else if (s == "WFD")
-        {
-            if (v[1] == "T1")
-            {
-                if (v.size() == 4)
-                {
-                    return new AlgoWFD_T1(algo_name, instance,
-                                          map_str_to_measure.at(v[2]),
-                                          map_str_to_weight.at(v[3]),
-                                          isRatioWeight(v[3]));
-                }
-                else if ((v.size() == 5) && (v[4] == "Dyn"))
-                {
-                    return new AlgoWFD_T1(algo_name, instance,
-                                          map_str_to_measure.at(v[2]),
-                                          map_str_to_weight.at(v[3]),
-                                          true);
-                }
-            }
-            else if (v[1] == "T2")
-            {
-                if (v.size() == 4)
-                {
-                    return new AlgoWFD_T2(algo_name, instance,
-                                          map_str_to_measure.at(v[2]),
-                                          map_str_to_weight.at(v[3]),
-                                          false);
-                }
-                else if ((v.size() == 5) && (v[4] == "Dyn"))
-                {
-                    return new AlgoWFD_T2(algo_name, instance,
-                                          map_str_to_measure.at(v[2]),
-                                          map_str_to_weight.at(v[3]),
-                                          true);
-                }
-            }
-            else if (v[1] == "T3")
-            {
-                if (v.size() == 5)
-                {
-                    return new AlgoWFD_T3(algo_name, instance,
-                                          map_str_to_measure.at(v[2]),
-                                          map_str_to_weight.at(v[3]),
-                                          map_str_to_weight.at(v[4]),
-                                          false);
-                }
-                else if ((v.size() == 6) && (v[5] == "Dyn"))
-                {
-                    return new AlgoWFD_T3(algo_name, instance,
-                                          map_str_to_measure.at(v[2]),
-                                          map_str_to_weight.at(v[3]),
-                                          map_str_to_weight.at(v[4]),
-                                          true);
-                }
-            }
-        }
-        else if (s=="WF")
-        {
-            if (v.size() == 3)
-            {
-                return new AlgoWF(algo_name, instance,
-                                     map_str_to_measure.at(v[1]),
-                                     map_str_to_weight.at(v[2]));
-            }
-        }
-        else if(s == "BCS") // Bin-centric with Score algos
-        {
-            if(v.size() == 3)
-            {
-                // with static or ratio weights
-                return new AlgoBinCentric(algo_name, instance,
-                                          map_str_to_score.at(v[1]),
-                                          map_str_to_weight.at(v[2]),
-                                          isRatioWeight(v[2]),
-                                          false);
-            }
-            else if ((v.size() == 4) && (v[3] == "Dyn"))
-            {
-                // with dynamic weights
-                return new AlgoBinCentric(algo_name, instance,
-                                          map_str_to_score.at(v[1]),
-                                          map_str_to_weight.at(v[2]),
-                                          true,
-                                          false);
-            }
-            else if ((v.size() == 4) && (v[3] == "Bin"))
-            {
-                return new AlgoBinCentric(algo_name, instance,
-                                          map_str_to_score.at(v[1]),
-                                          map_str_to_weight.at(v[2]),
-                                          true,
-                                          true);
-            }
-        }
-    } // end try
-    catch (...)
+    AlgoSpec spec;
+    const AlgoFamily* family = findAlgoFamily(algo_name, spec);
+    if (family == nullptr)
     {
-        std::string err = "Incorrect measure or weight name. Could not create algorithm \'" + algo_name + "\'";
-        throw std::runtime_error(err);
+        throw std::runtime_error(unknownAlgoMessage(algo_name));
     }
-
-    std::string err_string = "Unknown algorithm name \'" + algo_name + "\'";
-    throw std::runtime_error(err_string);
+    const std::string first_token = splitString(family->getPattern())[0];
+    if ((family->isMultiBin() != multi_bin)
+        || (!first_tokens.empty() && (std::find(first_tokens.begin(), first_tokens.end(), first_token) == first_tokens.end())))
+    {
+        std::string err_string = "Algorithm \'" + algo_name + "\' is not " + kind;
+        throw std::runtime_error(err_string);
+    }
+    return family->create(algo_name, spec, instance);
 }
 
+BaseAlgo* createAlgoCentric(const std::string& algo_name, const Instance &instance)
+{
+    return createAlgoOfKind(algo_name, instance, "an item-centric or bin-centric algorithm", false, {});
+}
 
 AlgoPairing* createAlgoPairing(const std::string& algo_name, const Instance &instance)
 {
-    std::vector<std::string> v = splitString(algo_name);
-    const std::string& s = v[1];
+    return static_cast<AlgoPairing*>(createAlgoOfKind(algo_name, instance, "a Pairing algorithm", true, {"Pairing"}));
+}
 
-    try {
-        if (v[0] == "Pairing")
-        {
-            if (s == "BS")
-            {
-                // Bin-Item Pairing with Relaxed Binary Search
-                if (v.size() == 4)
-                {
-                    return new AlgoPairing_BinSearch(algo_name, instance,
-                                            map_str_to_score.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            isRatioWeight(v[3]), false);
-                }
-                else if ((v.size() == 5) && (v[4] == "Dyn"))
-                {
-                    return new AlgoPairing_BinSearch(algo_name, instance,
-                                            map_str_to_score.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            true, false);
-                }
-                else if ((v.size() == 5) && (v[4] == "Bin"))
-                {
-                    return new AlgoPairing_BinSearch(algo_name, instance,
-                                            map_str_to_score.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            true, true);
-                }
-            }
-            else if (s == "Incr")
-            {
-                // Bin-Item Pairing with increment bins
-                if (v.size() == 5)
-                {
-                    return new AlgoPairing_Increment(algo_name, instance,
-                                            map_str_to_score.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            isRatioWeight(v[3]), false,
-                                            std::stoi(v[4]));
-                }
-                else if ((v.size() == 6) && (v[4] == "Dyn"))
-                {
-                    return new AlgoPairing_Increment(algo_name, instance,
-                                            map_str_to_score.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            true, false,
-                                            std::stoi(v[5]));
-                }
-                else if ((v.size() == 6) && (v[4] == "Bin"))
-                {
-                    return new AlgoPairing_Increment(algo_name, instance,
-                                            map_str_to_score.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            true, true,
-                                            std::stoi(v[5]));
-                }
-            }
-        }
-    } // end try
-    catch (...)
+AlgoWFDm* createAlgoWFDm(const std::string& algo_name, const Instance &instance)
+{
+    return static_cast<AlgoWFDm*>(createAlgoOfKind(algo_name, instance, "a WFDm or BFDm algorithm", true, {"WFDm", "BFDm"}));
+}
+
+bool isMultiBinAlgo(const std::string& algo_name)
+{
+    AlgoSpec spec;
+    const AlgoFamily* family = findAlgoFamily(algo_name, spec);
+    return ((family != nullptr) && family->isMultiBin());
+}
+
+BaseAlgo* createAlgo(const std::string& algo_name, const Instance &instance)
+{
+    AlgoSpec spec;
+    const AlgoFamily* family = findAlgoFamily(algo_name, spec);
+    if (family == nullptr)
     {
-        std::string err = "Incorrect score or weight name. Could not create algorithm \'" + algo_name + "\'";
-        throw std::runtime_error(err);
+        throw std::runtime_error(unknownAlgoMessage(algo_name));
     }
-
-    std::string err_string = "Unknown algorithm name \'" + algo_name + "\'";
-    throw std::runtime_error(err_string);
+    return family->create(algo_name, spec, instance);
 }
 
+int computeUpperBoundFF(const Instance &instance, int hint_nb_bins, const CancelToken& token)
+{
+    const std::string algo_name("FF"); // The algorithm keeps a reference to its name
+    if (instance.getDimensions() == 1)
+    {
+        AlgoFF_1D algoFF(algo_name, instance);
+        algoFF.setCancelToken(token);
+        return algoFF.solveInstance(hint_nb_bins);
+    }
+    AlgoFF algoFF(algo_name, instance);
+    algoFF.setCancelToken(token);
+    return algoFF.solveInstance(hint_nb_bins);
+}
 
-AlgoWFDm* createAlgoWFDm(const std::string& algo_name, const Instance &instance)
+OnlinePacker* createOnlinePacker(const std::string& packer_name, const SizeList& capacities,
+                                 const Instance* sample)
 {
-    std::vector<std::string> v = splitString(algo_name);
-    const std::string& s = v[1];
+    std::vector<std::string> v = splitString(packer_name);
+    auto policy_it = v.empty() ? map_str_to_online_policy.end() : map_str_to_online_policy.find(v[0]);
+    if (policy_it == map_str_to_online_policy.end())
+    {
+        std::string err_string = "Unknown online packer name \'" + packer_name + "\'";
+        throw std::runtime_error(err_string);
+    }
 
-    try {
-        if (v[0] == "WFDm")
-        {
-            if (s == "BS")
-            {
-                // WFDm with Binary Search
-                if (v.size() == 4)
-                {
-                    return new AlgoWFDm_BinSearch(algo_name, instance,
-                                            map_str_to_measure.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            isRatioWeight(v[3]));
-                }
-                else if ((v.size() == 5) && (v[4] == "Dyn"))
-                {
-                    return new AlgoWFDm_BinSearch(algo_name, instance,
-                                            map_str_to_measure.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            true);
-                }
-            }
-            else if (s == "Incr")
-            {
-                // WFDm with increment bins
-                if (v.size() == 5)
-                {
-                    return new AlgoWFDm_Increment(algo_name, instance,
-                                            map_str_to_measure.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            isRatioWeight(v[3]),
-                                            std::stoi(v[4]));
-                }
-                else if ((v.size() == 6) && (v[4] == "Dyn"))
-                {
-                    return new AlgoWFDm_Increment(algo_name, instance,
-                                            map_str_to_measure.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            true,
-                                            std::stoi(v[5]));
-                }
-            }
-        }
-        else if (v[0] == "BFDm")
+    ONLINE_POLICY policy = policy_it->second;
+    if (policy == ONLINE_POLICY::FIRST_FIT)
+    {
+        if (v.size() != 1)
         {
-            if (s == "BS")
-            {
-                // BFDm with Binary Search
-                if (v.size() == 4)
-                {
-                    return new AlgoBFDm_BinSearch(algo_name, instance,
-                                            map_str_to_measure.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            isRatioWeight(v[3]));
-                }
-                else if ((v.size() == 5) && (v[4] == "Dyn"))
-                {
-                    return new AlgoBFDm_BinSearch(algo_name, instance,
-                                            map_str_to_measure.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            true);
-                }
-            }
-            else if (s == "Incr")
-            {
-                // BFDm with increment bins
-                if (v.size() == 5)
-                {
-                    return new AlgoBFDm_Increment(algo_name, instance,
-                                            map_str_to_measure.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            isRatioWeight(v[3]),
-                                            std::stoi(v[4]));
-                }
-                else if ((v.size() == 6) && (v[4] == "Dyn"))
-                {
-                    return new AlgoBFDm_Increment(algo_name, instance,
-                                            map_str_to_measure.at(v[2]),
-                                            map_str_to_weight.at(v[3]),
-                                            true,
-                                            std::stoi(v[5]));
-                }
-            }
+            std::string err_string = "Unknown online packer name \'" + packer_name + "\'";
+            throw std::runtime_error(err_string);
         }
-    } // end try
-    catch (...)
+        return new OnlinePacker(capacities, policy);
+    }
+
+    if ((v.size() != 3) || (map_str_to_measure.count(v[1]) == 0) || (map_str_to_weight.count(v[2]) == 0))
     {
-        std::string err = "Incorrect measure or weight name. Could not create algorithm \'" + algo_name + "\'";
+        std::string err = "Incorrect measure or weight name. Could not create online packer \'" + packer_name + "\'";
+        throw std::runtime_error(err);
+    }
+    if (isRatioWeight(v[2]))
+    {
+        std::string err = "Ratio weights depend on the items still to pack, they are not supported by online packer \'" + packer_name + "\'";
         throw std::runtime_error(err);
     }
 
-    std::string err_string = "Unknown algorithm name \'" + algo_name + "\'";
-    throw std::runtime_error(err_string);
+    int dimensions = capacities.size();
+    WEIGHT weight = map_str_to_weight.at(v[2]);
+    FloatList weights_list(dimensions, 1.0);
+    if (weight != WEIGHT::UNIT)
+    {
+        if ((sample == nullptr) || (sample->getDimensions() != dimensions) || (sample->getNbItems() == 0))
+        {
+            std::string err = "Online packer \'" + packer_name + "\' needs a non-empty sample instance with "
+                + std::to_string(dimensions) + " dimensions to compute its weights";
+            throw std::runtime_error(err);
+        }
+        utilComputeWeights(weight, dimensions, sample->getNbItems(), weights_list, sample->getTotalNormSizes());
+    }
+    return new OnlinePacker(capacities, policy, map_str_to_measure.at(v[1]), weights_list);
 }
 
+int solveWithAlgo(BaseAlgo* algo, const std::string& algo_name, int LB, int UB)
+{
+    if (isMultiBinAlgo(algo_name))
+    {
+        return algo->solveInstanceMultiBin(LB, UB);
+    }
+    return algo->solveInstance(LB);
+}
@@ -3,9 +3,13 @@
 
 #include "base_algo.hpp"
 #include "algos_ItemCentric.hpp"
+#include "algos_OneDim.hpp"
+#include "algos_TwoDim.hpp"
 #include "algos_BinCentric.hpp"
 #include "algos_MultiBin.hpp"
 #include "lower_bounds.hpp"
+#include "online_packer.hpp"
+#include "algo_registry.hpp"
 
 #include <string>
 
@@ -20,7 +24,27 @@ BaseAlgo* createAlgoCentric(const std::string& algo_name, const Instance &instan
 
 // Creator of multi-bin algorithms
 AlgoPairing* createAlgoPairing(const std::string& algo_name, const Instance &instance);
-AlgoWFDm* createAlgoWFDm(const std::string& algo_name, const Instance &instance);
+AlgoWFDm* createAlgoWFDm(const std::string& algo_name, const Instance &instance); // Also BFDm algorithms
+
+// Whether algo_name is a multi-bin algorithm (to be solved with solveInstanceMultiBin)
+bool isMultiBinAlgo(const std::string& algo_name);
+
+// Creator of any algorithm w.r.t. given algo_name, see the families of algo_registry.hpp
+BaseAlgo* createAlgo(const std::string& algo_name, const Instance &instance);
+
+// Upper bound given by the First Fit algorithm, used by multi-bin algorithms
+// Throws SolveCancelled soon after the token is cancelled
+int computeUpperBoundFF(const Instance &instance, int hint_nb_bins = 0, const CancelToken& token = CancelToken());
+
+// Creator of online packers: FF, BF-<measure>-<weight> or WF-<measure>-<weight>
+// Weights other than Unit are computed once from the items of the sample instance (e.g. a past workload)
+// Dynamic and ratio weights are not supported, as they depend on the items still to pack
+OnlinePacker* createOnlinePacker(const std::string& packer_name, const SizeList& capacities,
+                                 const Instance* sample = nullptr);
+
+// Run the algorithm with the right solve method
+// UB is only used by multi-bin algorithms
+int solveWithAlgo(BaseAlgo* algo, const std::string& algo_name, int LB, int UB);
 
 #endif // UTILS_VECTORPACK_HPP
  
@@ -17,15 +17,8 @@ AlgoBinCentric::AlgoBinCentric(const std::string &algo_name, const Instance &ins
     is_ratio_weight(false),
     use_bin_weights(use_bin_weights)
 {
-    // Compute total normalized size of all items
-    total_norm_size = FloatList(dimensions, 0.0);
-    for(Item * item : items)
-    {
-        for (int h = 0; h < dimensions; ++h)
-        {
-            total_norm_size[h] += item->getNormSizeDim(h);
-        }
-    }
+    // Total normalized size of all items
+    total_norm_size = instance.getTotalNormSizes();
 
     if (weight == WEIGHT::UTILIZATION_RATIO)
     {
@@ -50,7 +43,7 @@ AlgoBinCentric::AlgoBinCentric(const std::string &algo_name, const Instance &ins
         // to ease computation of scaling factor for DP2 scores
         for (Item * item : items)
         {
-            item->setMeasure(1.0 / utilComputeNorm2(item->getSizes(), bin_max_capacities));
+            setItemMeasure(item, 1.0 / utilComputeNorm2(item->getSizes(), bin_max_capacities));
         }
     }
 }
@@ -69,7 +62,7 @@ Bin* AlgoBinCentric::createNewBin()
     if ((score == SCORE::DOT_PRODUCT2) || (score == SCORE::DOT_PRODUCT3))
     {
         // Set the norm2 of residual capacity of the bin
-        bin->setMeasure(utilComputeNorm2(bin->getAvailableCaps(), bin->getMaxCaps()));
+        bin->setMeasure(utilComputeNorm2(bin->getNormAvailableCaps()));
     }
 
     return bin;
@@ -89,7 +82,7 @@ void AlgoBinCentric::addItemToBin(Item *item, Bin *bin)
     if ((score == SCORE::DOT_PRODUCT2) || (score == SCORE::DOT_PRODUCT3))
     {
         // Update norm2 of the bin
-        bin->setMeasure(utilComputeNorm2(bin->getAvailableCaps(), bin->getMaxCaps()));
+        bin->setMeasure(utilComputeNorm2(bin->getNormAvailableCaps()));
     }
 
     if (dynamic_weights)
@@ -103,95 +96,136 @@ void AlgoBinCentric::addItemToBin(Item *item, Bin *bin)
 }
 
 
-float AlgoBinCentric::computeItemBinScore(Item* item, Bin* bin)
+template<SCORE S>
+float AlgoBinCentric::computeScore(Item* item, Bin* bin)
 {
+    VP_COUNT(stats.score_evaluations, 1);
     float score_value = 0.0;
-    switch(score)
+    const FloatList& norm_sizes = item->getNormSizes();
+    const SizeList& residuals = bin->getAvailableCaps();
+    // The scores keep the order of operations of the division by the capacity, only L2NORM
+    // reads the normalized residual capacities cached in the bin (the same value)
+    if constexpr ((S == SCORE::DOT_PRODUCT1) || (S == SCORE::DOT_PRODUCT2) || (S == SCORE::DOT_PRODUCT3))
     {
-    case SCORE::DOT_PRODUCT1:
         for (int h = 0; h < dimensions; ++h)
         {
             // Use normalized values of item size and bin residual capacity
-            score_value += weights_list[h] * item->getNormSizeDim(h) * bin->getAvailableCapDim(h) / (float)bin_max_capacities[h];
+            score_value += weights_list[h] * norm_sizes[h] * residuals[h] / (float)bin_max_capacities[h];
         }
-        break;
-    case SCORE::DOT_PRODUCT2:
-        for (int h = 0; h < dimensions; ++h)
+        if constexpr (S == SCORE::DOT_PRODUCT2)
         {
-            // Use normalized values of item size and bin residual capacity
-            score_value += weights_list[h] * item->getNormSizeDim(h) * bin->getAvailableCapDim(h) / (float)bin_max_capacities[h];
+            // Scaling factor 1/(norm2 item size * norm2 bin capacity)
+            // item measure holds 1/norm2 size; bin measure holds norm2 bin capacity
+            score_value = score_value * getItemMeasure(item) / bin->getMeasure();
         }
-        // Scaling factor 1/(norm2 item size * norm2 bin capacity)
-        // item measure holds 1/norm2 size; bin measure holds norm2 bin capacity
-        score_value = score_value * item->getMeasure() / bin->getMeasure();
-        break;
-    case SCORE::DOT_PRODUCT3:
-        for (int h = 0; h < dimensions; ++h)
+        else if constexpr (S == SCORE::DOT_PRODUCT3)
         {
-            // Use normalized values of item size and bin residual capacity
-            score_value += weights_list[h] * item->getNormSizeDim(h) * bin->getAvailableCapDim(h) / (float)bin_max_capacities[h];
+            // Scaling factor 1/(norm2 bin capacity * norm2 bin capacity)
+            // bin measure holds norm2 bin capacity
+            score_value = score_value / (bin->getMeasure() * bin->getMeasure());
         }
-        // Scaling factor 1/(norm2 bin capacity * norm2 bin capacity)
-        // bin measure holds norm2 bin capacity
-        score_value = score_value / (bin->getMeasure() * bin->getMeasure());
-        break;
-    case SCORE::NORM_DOT_PRODUCT:
+    }
+    else if constexpr (S == SCORE::NORM_DOT_PRODUCT)
+    {
         for (int h = 0; h < dimensions; ++h)
         {
             if ((total_norm_size[h] > ZERO_THRESHOLD) && (total_norm_residual_capacity[h] > ZERO_THRESHOLD))
             {
-                score_value += weights_list[h] * (item->getNormSizeDim(h) * bin->getAvailableCapDim(h))/ (float)(total_norm_size[h] * bin_max_capacities[h] * total_norm_residual_capacity[h]);
+                score_value += weights_list[h] * (norm_sizes[h] * residuals[h]) / (float)(total_norm_size[h] * bin_max_capacities[h] * total_norm_residual_capacity[h]);
             }
             // Else, desactivate that dimension for the computation of score
         }
-        break;
-    case SCORE::L2NORM:
+    }
+    else if constexpr (S == SCORE::L2NORM)
+    {
+        const FloatList& norm_residuals = bin->getNormAvailableCaps();
         for (int h = 0; h < dimensions; ++h)
         {
-            float f = (bin->getAvailableCapDim(h) / (float)bin_max_capacities[h]) - item->getNormSizeDim(h);
+            float f = norm_residuals[h] - norm_sizes[h];
             score_value -= weights_list[h] * f*f;
         }
-        break;
-    case SCORE::TIGHT_FILL_SUM:
+    }
+    else if constexpr (S == SCORE::TIGHT_FILL_SUM)
+    {
         for (int h = 0; h < dimensions; ++h)
         {
             // Use normalized values of item size and bin residual capacity
-            score_value += weights_list[h] * item->getNormSizeDim(h) * bin_max_capacities[h] / (float)bin->getAvailableCapDim(h);
+            score_value += weights_list[h] * norm_sizes[h] * bin_max_capacities[h] / (float)residuals[h];
         }
-        break;
-    case SCORE::TIGHT_FILL_MIN:
-        {
-            bool inited = false;
-            score_value = std::numeric_limits<float>::max(); // +infinity
+    }
+    else // SCORE::TIGHT_FILL_MIN
+    {
+        bool inited = false;
+        score_value = std::numeric_limits<float>::max(); // +infinity
 
-            for (int h = 0; h < dimensions; ++h)
+        for (int h = 0; h < dimensions; ++h)
+        {
+            // Use normalized values of item size and bin residual capacity
+            if (weights_list[h] != 0.0)
             {
-                // Use normalized values of item size and bin residual capacity
-                if (weights_list[h] != 0.0)
-                {
-                    score_value = std::min(score_value, weights_list[h] * item->getNormSizeDim(h) * bin_max_capacities[h] / (float)bin->getAvailableCapDim(h));
-                    inited = true;
-                }
-                // Otherwise, the dimension has been deactivated by setting its weight to 0
+                score_value = std::min(score_value, weights_list[h] * norm_sizes[h] * bin_max_capacities[h] / (float)residuals[h]);
+                inited = true;
             }
+            // Otherwise, the dimension has been deactivated by setting its weight to 0
+        }
 
-            if (!inited)
-            {
-                score_value = 0; // If all dimensions were deactivated, set the score to 0
-            }
+        if (!inited)
+        {
+            score_value = 0; // If all dimensions were deactivated, set the score to 0
         }
-        break;
     }
 
     return score_value;
 }
 
+float AlgoBinCentric::computeItemBinScore(Item* item, Bin* bin)
+{
+    switch(score)
+    {
+    case SCORE::DOT_PRODUCT1:
+        return computeScore<SCORE::DOT_PRODUCT1>(item, bin);
+    case SCORE::DOT_PRODUCT2:
+        return computeScore<SCORE::DOT_PRODUCT2>(item, bin);
+    case SCORE::DOT_PRODUCT3:
+        return computeScore<SCORE::DOT_PRODUCT3>(item, bin);
+    case SCORE::NORM_DOT_PRODUCT:
+        return computeScore<SCORE::NORM_DOT_PRODUCT>(item, bin);
+    case SCORE::L2NORM:
+        return computeScore<SCORE::L2NORM>(item, bin);
+    case SCORE::TIGHT_FILL_SUM:
+        return computeScore<SCORE::TIGHT_FILL_SUM>(item, bin);
+    case SCORE::TIGHT_FILL_MIN:
+        return computeScore<SCORE::TIGHT_FILL_MIN>(item, bin);
+    }
+    return 0.0;
+}
+
+void AlgoBinCentric::computeWeights(int remaining_items)
+{
+    if (is_ratio_weight)
+    {
+        utilComputeWeightsRatio(weight, dimensions, weights_list, total_norm_size, total_norm_residual_capacity);
+    }
+    else
+    {
+        if (use_bin_weights)
+        {
+            utilComputeWeights(weight, dimensions, bins.size(), weights_list, total_norm_residual_capacity);
+        }
+        else
+        {
+            utilComputeWeights(weight, dimensions, remaining_items, weights_list, total_norm_size);
+        }
+    }
+}
+
 int AlgoBinCentric::solveInstance(int hint_nb_bins)
 {
     if(isSolved())
     {
         return getSolution(); // No need to solve it twice
     }
+    ScopedPhaseTimer phase_timer(timings, "solveInstance");
     if (hint_nb_bins > 0)
     {
         bins.reserve(hint_nb_bins);
@@ -205,28 +239,14 @@ int AlgoBinCentric::solveInstance(int hint_nb_bins)
 
     if (!dynamic_weights)
     {
-        // Compute weights only once
-        if (is_ratio_weight)
-        {
-            // This should never be reached, as ratio weights are dynamic
-            utilComputeWeightsRatio(weight, dimensions, weights_list, total_norm_size, total_norm_residual_capacity);
-        }
-        else
-        {
-            if (use_bin_weights)
-            {
-                // This should never be reached, as bin-based weights are dynamic
-                utilComputeWeights(weight, dimensions, bins.size(), weights_list, total_norm_residual_capacity);
-            }
-            else
-            {
-                utilComputeWeights(weight, dimensions, remaining_items, weights_list, total_norm_size);
-            }
-        }
+        // Compute weights only once (ratio and bin-based weights are always dynamic)
+        computeWeights(remaining_items);
     } // Otherwise, weights will be re-computed before computing scores
 
     while(first_item_it != end_items_it) // While there are items to pack
     {
+        checkCancelled();
+
         // Compute maximum score and get the item
         auto max_score_it = end_items_it;
         float max_score_val = std::numeric_limits<float>::lowest(); // -infinity
@@ -234,27 +254,13 @@ int AlgoBinCentric::solveInstance(int hint_nb_bins)
         if (dynamic_weights)
         {
             // Update weights
-            if (is_ratio_weight)
-            {
-                utilComputeWeightsRatio(weight, dimensions, weights_list, total_norm_size, total_norm_residual_capacity);
-            }
-            else
-            {
-                if (use_bin_weights)
-                {
-                    utilComputeWeights(weight, dimensions, bins.size(), weights_list, total_norm_residual_capacity);
-                }
-                else
-                {
-                    utilComputeWeights(weight, dimensions, remaining_items, weights_list, total_norm_size);
-                }
-            }
+            computeWeights(remaining_items);
         }
 
         // For each item, if it is feasible, compute its score
         for(auto curr_item_it = first_item_it; curr_item_it != end_items_it; ++curr_item_it)
         {
-            if (curr_bin->doesItemFit((*curr_item_it)->getSizes()))
+            if (countFitCheck(curr_bin->doesItemFit((*curr_item_it)->getSizes())))
             {
                 float score = computeItemBinScore((*curr_item_it), curr_bin);
                 if (score > max_score_val)
@@ -299,3 +305,115 @@ int AlgoBinCentric::solveInstanceMultiBin(int LB, int UB)
     std::string s = "With BinCentric-type algorithm please call 'solveInstance' instead.";
     throw std::runtime_error(s);
 }
+
+
+
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+// Same loop as AlgoBinCentric::solveInstance, with the score and the dynamic flag known at compile time
+template<SCORE S, bool DYNAMIC>
+int AlgoBinCentricEngine<S, DYNAMIC>::solveInstance(int hint_nb_bins)
+{
+    if(isSolved())
+    {
+        return getSolution(); // No need to solve it twice
+    }
+    if (dynamic_weights != DYNAMIC)
+    {
+        std::string s = "Algo " + name + " was not instantiated with the right dynamic weights flag";
+        throw std::runtime_error(s);
+    }
+    ScopedPhaseTimer phase_timer(timings, "solveInstance");
+    if (hint_nb_bins > 0)
+    {
+        bins.reserve(hint_nb_bins);
+    }
+
+    int total_items = instance.getNbItems();
+    Bin* curr_bin = AlgoBinCentric::createNewBin();
+    auto first_item_it = items.begin();
+    auto end_items_it = items.end();
+    int remaining_items = end_items_it - first_item_it;
+
+    if constexpr (!DYNAMIC)
+    {
+        // Compute weights only once (ratio and bin-based weights are always dynamic)
+        computeWeights(remaining_items);
+    } // Otherwise, weights will be re-computed before computing scores
+
+    while(first_item_it != end_items_it) // While there are items to pack
+    {
+        checkCancelled();
+
+        // Compute maximum score and get the item
+        auto max_score_it = end_items_it;
+        float max_score_val = std::numeric_limits<float>::lowest(); // -infinity
+
+        if constexpr (DYNAMIC)
+        {
+            // Update weights
+            computeWeights(remaining_items);
+        }
+
+        // For each item, if it is feasible, compute its score
+        for(auto curr_item_it = first_item_it; curr_item_it != end_items_it; ++curr_item_it)
+        {
+            if (countFitCheck(curr_bin->doesItemFit((*curr_item_it)->getSizes())))
+            {
+                float score = computeScore<S>((*curr_item_it), curr_bin);
+                if (score > max_score_val)
+                {
+                    max_score_val = score;
+                    max_score_it = curr_item_it;
+                }
+            }
+        }
+
+        if (max_score_it != end_items_it)
+        {
+            // There is a feasible item
+            AlgoBinCentric::addItemToBin(*max_score_it, curr_bin);
+            --remaining_items;
+
+            // Put this item at beginning of the list and advance the first iterator
+            std::iter_swap(max_score_it, first_item_it);
+            first_item_it++;
+        }
+        else
+        {
+            // There is no feasible item, create a new bin
+            curr_bin = AlgoBinCentric::createNewBin();
+
+            // This is a quick safe guard to avoid infinite loops and running out of memory
+            if ((int)bins.size() > total_items)
+            {
+                std::string s = "There seem to be a problem with algo " + name + " and instance " + instance.getName() + ", created more bins than items (" + std::to_string(bins.size()) + ").";
+                throw std::runtime_error(s);
+            }
+        }
+    }
+
+    solved = true;
+    return getSolution();
+}
+
+template<SCORE S, bool DYNAMIC>
+float AlgoBinCentricEngine<S, DYNAMIC>::computeItemBinScore(Item* item, Bin* bin)
+{
+    return computeScore<S>(item, bin);
+}
+
+// All combinations created by the algorithm registry
+#define INSTANTIATE_BIN_CENTRIC_ENGINE(S) \
+    template class AlgoBinCentricEngine<S, false>; \
+    template class AlgoBinCentricEngine<S, true>;
+
+INSTANTIATE_BIN_CENTRIC_ENGINE(SCORE::DOT_PRODUCT1)
+INSTANTIATE_BIN_CENTRIC_ENGINE(SCORE::DOT_PRODUCT2)
+INSTANTIATE_BIN_CENTRIC_ENGINE(SCORE::DOT_PRODUCT3)
+INSTANTIATE_BIN_CENTRIC_ENGINE(SCORE::NORM_DOT_PRODUCT)
+INSTANTIATE_BIN_CENTRIC_ENGINE(SCORE::L2NORM)
+INSTANTIATE_BIN_CENTRIC_ENGINE(SCORE::TIGHT_FILL_SUM)
+INSTANTIATE_BIN_CENTRIC_ENGINE(SCORE::TIGHT_FILL_MIN)
+#undef INSTANTIATE_BIN_CENTRIC_ENGINE
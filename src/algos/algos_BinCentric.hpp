@@ -23,6 +23,9 @@ protected:
     virtual Bin* createNewBin();
     virtual void addItemToBin(Item* item, Bin* bin);
     virtual float computeItemBinScore(Item* item, Bin* bin);
+    template<SCORE S>
+    float computeScore(Item* item, Bin* bin); // The score is known at compile time
+    void computeWeights(int remaining_items);
 
 protected:
     const SCORE score;
@@ -36,4 +39,25 @@ protected:
     FloatList total_norm_residual_capacity; // The list of residual capacity of all bins (normalized values)
 };
 
+
+
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+// Engine of AlgoBinCentric with the score and whether the weights are dynamic as template parameters:
+// the loop computing the scores of all items calls no virtual method and does not switch on the score
+// DYNAMIC must be the dynamic_weights flag set by the constructor (also true for ratio and bin weights)
+// Instantiated in algos_BinCentric.cpp for each score, created by the algorithm registry
+template<SCORE S, bool DYNAMIC>
+class AlgoBinCentricEngine final : public AlgoBinCentric
+{
+public:
+    using AlgoBinCentric::AlgoBinCentric;
+
+    virtual int solveInstance(int hint_nb_bins = 0);
+
+protected:
+    virtual float computeItemBinScore(Item* item, Bin* bin);
+};
+
 #endif // ALGOS_BINC_HPP
@@ -20,6 +20,33 @@ void AlgoFit::sortItems(ItemList::iterator first_item, ItemList::iterator end_it
 void AlgoFit::computeItemMeasures(ItemList::iterator first_item, ItemList::iterator end_it)
 { }
 
+void AlgoFit::initItemOrder()
+{
+    std::string key = getItemOrderKey();
+    if (!key.empty() && instance.getCachedItemOrder(key, items))
+    {
+        // Same ordering already computed by another algorithm or a previous call
+        return;
+    }
+
+    // Pre-processing to compute combined size measure of all items
+    computeItemMeasures(items.begin(), items.end());
+
+    // Renumber items in decreasing size
+    sortItems(items.begin(), items.end());
+
+    if (!key.empty())
+    {
+        instance.setCachedItemOrder(key, items);
+    }
+}
+
+// Empty key by default: the order is not shared
+std::string AlgoFit::getItemOrderKey() const
+{
+    return "";
+}
+
 
 // Generic algorithm based on first fit
 // The hint is an estimate on the number of bins to allocate
@@ -29,6 +56,7 @@ int AlgoFit::solveInstance(int hint_nb_bins)
     {
         return getSolution(); // No need to solve twice
     }
+    ScopedPhaseTimer phase_timer(timings, "solveInstance");
     if(hint_nb_bins > 0)
     {
         bins.reserve(hint_nb_bins); // Small memory optimisation
@@ -36,11 +64,8 @@ int AlgoFit::solveInstance(int hint_nb_bins)
 
     if (is_FFD_type)
     {
-        // Pre-processing to compute combined size measure of all items
-        computeItemMeasures(items.begin(), items.end());
-
-        // Renumber items in decreasing size
-        sortItems(items.begin(), items.end());
+        // Compute item measures and renumber items in decreasing size
+        initItemOrder();
     }
 
     bool allocated = false;
@@ -51,12 +76,14 @@ int AlgoFit::solveInstance(int hint_nb_bins)
     auto end_items_it = items.end();
     while(curr_item_it != end_items_it)
     {
+        checkCancelled();
         Item * item = *curr_item_it;
 
         auto curr_bin_it = bins.begin();
         allocated = false;
         while ((!allocated) && (curr_bin_it != bins.end()))
         {
+            VP_COUNT(stats.bins_scanned, 1);
             if (checkItemToBin(item, *curr_bin_it))
             {
                 addItemToBin(item, *curr_bin_it);
@@ -146,14 +173,7 @@ AlgoFFD::AlgoFFD(const std::string& algo_name, const Instance &instance,
     }
 
     // The value of total_norm_size is kept and updated after each packing of item in case of dynamic weights
-    total_norm_size = FloatList(dimensions, 0.0);
-    for(Item * item : items)
-    {
-        for (int h = 0; h < dimensions; ++h)
-        {
-            total_norm_size[h] += item->getNormSizeDim(h);
-        }
-    }
+    total_norm_size = instance.getTotalNormSizes();
 }
 
 void AlgoFFD::addItemToBin(Item* item, Bin* bin)
@@ -194,19 +214,24 @@ Bin* AlgoFFD::createNewBin()
 
 void AlgoFFD::sortItems(ItemList::iterator first_item, ItemList::iterator end_it)
 {
+    auto compare_method = [this](Item* itema, Item* itemb) {
+        return (getItemMeasure(itema) > getItemMeasure(itemb));
+    };
+
     if (is_FFD_dynamic)
     {
         // Only need to bring forward the item of highest measure
         // as this function will be called again after the packing of each item
-        bubble_items_up(first_item, end_it, item_comparator_measure_decreasing);
+        countBubble(bubble_items_up(first_item, end_it, compare_method));
     }
     else
     {
-        stable_sort(first_item, end_it, item_comparator_measure_decreasing);
+        countSort(end_it - first_item);
+        stable_sort(first_item, end_it, compare_method);
     }
 }
 
-void AlgoFFD::computeItemMeasures(ItemList::iterator first_item, ItemList::iterator end_it)
+void AlgoFFD::computeItemWeights(int nb_items)
 {
     if (is_ratio_weight)
     {
@@ -214,49 +239,62 @@ void AlgoFFD::computeItemMeasures(ItemList::iterator first_item, ItemList::itera
     }
     else
     {
-        utilComputeWeights(weight, dimensions, (end_it - first_item), weights_list, total_norm_size);
+        utilComputeWeights(weight, dimensions, nb_items, weights_list, total_norm_size);
+    }
+}
+
+void AlgoFFD::initItemOrder()
+{
+    // Weights are also used for bin measures, they must be computed
+    // even if the item order is retrieved from the cache
+    computeItemWeights(items.size());
+    AlgoFit::initItemOrder();
+}
+
+std::string AlgoFFD::getItemOrderKey() const
+{
+    if (is_FFD_dynamic)
+    {
+        // Dynamic and ratio weights depend on the packing, the order cannot be shared
+        return "";
+    }
+
+    // Items measures are computed the same for L2 and L2_LOAD
+    MEASURE key_measure = size_measure;
+    if (key_measure == MEASURE::L2_LOAD)
+    {
+        key_measure = MEASURE::L2;
+    }
+    return "Measure" + std::to_string((int)key_measure) + "-Weight" + std::to_string((int)weight);
+}
+
+template<MEASURE M>
+void AlgoFFD::setItemMeasures(ItemList::iterator first_item, ItemList::iterator end_it)
+{
+    for (auto item_it = first_item; item_it != end_it; ++item_it)
+    {
+        Item* item = *item_it;
+        setItemMeasure(item, utilItemMeasure<M>(weights_list, item->getNormSizes(), dimensions));
     }
+}
+
+void AlgoFFD::computeItemMeasures(ItemList::iterator first_item, ItemList::iterator end_it)
+{
+    computeItemWeights(end_it - first_item);
 
     switch(size_measure)
     {
     case MEASURE::LINF:
-        for(auto item_it = first_item; item_it != end_it; ++item_it)
-        {
-            Item * item = *item_it;
-            float max_size = 0.0;
-            for (int h = 0; h < dimensions; ++h)
-            {
-                max_size = std::max(max_size, weights_list[h] * item->getNormSizeDim(h));
-            }
-            item->setMeasure(max_size);
-        }
+        setItemMeasures<MEASURE::LINF>(first_item, end_it);
         break;
     case MEASURE::L1:
-        for(auto item_it = first_item; item_it != end_it; ++item_it)
-        {
-            Item * item = *item_it;
-            float item_size = 0.0;
-            for (int h = 0; h < dimensions; ++h)
-            {
-                item_size += weights_list[h] * item->getNormSizeDim(h);
-            }
-            item->setMeasure(item_size);
-        }
+        setItemMeasures<MEASURE::L1>(first_item, end_it);
         break;
     case MEASURE::L2:
+        setItemMeasures<MEASURE::L2>(first_item, end_it);
+        break;
     case MEASURE::L2_LOAD:
-        // For these 2 measures, the item measure is computed the same
-        for (auto item_it = first_item; item_it != end_it; ++item_it)
-        {
-            Item* item = *item_it;
-            float value = 0.0;
-            for (int h = 0; h < dimensions; ++h)
-            {
-                value += weights_list[h] * item->getNormSizeDim(h) * item->getNormSizeDim(h);
-            }
-            //item->setMeasure(std::sqrt(value));
-            item->setMeasure(value); // No need to compute the sqrt for ordering items
-        }
+        setItemMeasures<MEASURE::L2_LOAD>(first_item, end_it);
         break;
     }
 }
@@ -285,14 +323,15 @@ void AlgoBFD_T1::sortBins()
         }
 
         // Then re-order the whole list of bins
+        countSort(bins.size());
         stable_sort(bins.begin(), bins.end(), bin_comparator_measure_increasing);
     }
     else
     {
         // The measure of only one bin has changed, no need to perform complete sort
         // but the bubbling in BOTH directions is required, as it depends on the size measures
-        bubble_bin_up(bins.begin(), bins.end(), bin_comparator_measure_increasing);
-        bubble_bin_down(bins.begin(), bins.end(), bin_comparator_measure_decreasing);
+        countBubble(bubble_bin_up(bins.begin(), bins.end(), bin_comparator_measure_increasing));
+        countBubble(bubble_bin_down(bins.begin(), bins.end(), bin_comparator_measure_decreasing));
     }
 }
 
@@ -319,44 +358,19 @@ void AlgoBFD_T1::addItemToBin(Item *item, Bin *bin)
 
 void AlgoBFD_T1::updateBinMeasure(Bin *bin)
 {
-    float val_residual = 0.0;
     switch(size_measure)
     {
     case MEASURE::LINF:
-        for (int h = 0; h < dimensions; ++h)
-        {
-            // We need the normalized residual bin capacity
-            val_residual = std::max(val_residual, weights_list[h] * ((float)bin->getAvailableCapDim(h)) / bin_max_capacities[h]);
-        }
-        bin->setMeasure(val_residual);
+        bin->setMeasure(utilBinMeasure<MEASURE::LINF>(weights_list, bin, dimensions));
         break;
     case MEASURE::L1:
-        for (int h = 0; h < dimensions; ++h)
-        {
-            // We need the normalized residual bin capacity
-            val_residual += weights_list[h] * ((float)bin->getAvailableCapDim(h)) / bin_max_capacities[h];
-        }
-        bin->setMeasure(val_residual);
+        bin->setMeasure(utilBinMeasure<MEASURE::L1>(weights_list, bin, dimensions));
         break;
     case MEASURE::L2:
-        for (int h = 0; h < dimensions; ++h)
-        {
-            // Need normalized values
-            float f = ((float)bin->getAvailableCapDim(h)) / bin_max_capacities[h];
-            val_residual += weights_list[h] * f*f;
-        }
-        //bin->setMeasure(std::sqrt(val_residual));
-        bin->setMeasure(val_residual);
+        bin->setMeasure(utilBinMeasure<MEASURE::L2>(weights_list, bin, dimensions));
         break;
     case MEASURE::L2_LOAD:
-        for (int h = 0; h < dimensions; ++h)
-        {
-            // Normalized value of used capacity (normalized load of the bin)
-            float f = ((float)(bin_max_capacities[h] - bin->getAvailableCapDim(h))) / bin_max_capacities[h];
-            val_residual += weights_list[h] * f*f;
-        }
-        //bin->setMeasure(std::sqrt(val_residual));
-        bin->setMeasure(val_residual);
+        bin->setMeasure(utilBinMeasure<MEASURE::L2_LOAD>(weights_list, bin, dimensions));
         break;
     }
 }
@@ -392,6 +406,7 @@ Bin* AlgoBFD_T2::createNewBin()
 void AlgoBFD_T2::sortBins()
 {
     // The measure of all bins have been updated, need to re-order the whole list
+    countSort(bins.size());
     stable_sort(bins.begin(), bins.end(), bin_comparator_measure_increasing);
 }
 
@@ -417,9 +432,8 @@ void AlgoBFD_T2::addItemToBin(Item *item, Bin *bin)
 }
 
 
-void AlgoBFD_T2::updateBinMeasures()
+void AlgoBFD_T2::computeBinWeights()
 {
-    // For type2 BFD, need to update measure of ALL bins
     if (is_ratio_weight)
     {
         utilComputeWeightsRatio(bin_weight, dimensions, bin_weights_list, total_norm_size, total_norm_residual_capacity);
@@ -428,60 +442,35 @@ void AlgoBFD_T2::updateBinMeasures()
     {
         utilComputeWeights(bin_weight, dimensions, bins.size(), bin_weights_list, total_norm_residual_capacity);
     }
+}
+
+template<MEASURE M>
+void AlgoBFD_T2::setBinMeasures()
+{
+    for (Bin* b : bins)
+    {
+        b->setMeasure(utilBinMeasure<M>(bin_weights_list, b, dimensions));
+    }
+}
+
+void AlgoBFD_T2::updateBinMeasures()
+{
+    // For type2 BFD, need to update measure of ALL bins
+    computeBinWeights();
 
     switch(size_measure)
     {
     case MEASURE::LINF:
-        for (Bin* b : bins)
-        {
-            float max_residual = 0.0;
-            for (int h = 0; h < dimensions; ++h)
-            {
-                // We need the normalized residual bin capacity
-                max_residual = std::max(max_residual, bin_weights_list[h] * ((float)b->getAvailableCapDim(h)) / bin_max_capacities[h]);
-            }
-            b->setMeasure(max_residual);
-        }
+        setBinMeasures<MEASURE::LINF>();
         break;
     case MEASURE::L1:
-        for (Bin* b : bins)
-        {
-            float bin_residual = 0.0;
-            for (int h = 0; h < dimensions; ++h)
-            {
-                // We need the normalized residual bin capacity
-                bin_residual += bin_weights_list[h] * ((float)b->getAvailableCapDim(h)) / bin_max_capacities[h];
-            }
-            b->setMeasure(bin_residual);
-        }
+        setBinMeasures<MEASURE::L1>();
         break;
     case MEASURE::L2:
-        for (Bin* b : bins)
-        {
-            float value = 0.0;
-            for (int h = 0; h < dimensions; ++h)
-            {
-                // Need normalized values
-                float f = ((float)b->getAvailableCapDim(h)) / bin_max_capacities[h];
-                value += bin_weights_list[h] * f*f;
-            }
-            //b->setMeasure(std::sqrt(value));
-            b->setMeasure(value);
-        }
+        setBinMeasures<MEASURE::L2>();
         break;
     case MEASURE::L2_LOAD:
-        for (Bin* b : bins)
-        {
-            float value = 0.0;
-            for (int h = 0; h < dimensions; ++h)
-            {
-                // Normalized value of used capacity (normalized load of the bin)
-                float f = ((float)(bin_max_capacities[h] - b->getAvailableCapDim(h))) / bin_max_capacities[h];
-                value += bin_weights_list[h] * f*f;
-            }
-            //b->setMeasure(std::sqrt(value));
-            b->setMeasure(value);
-        }
+        setBinMeasures<MEASURE::L2_LOAD>();
         break;
     }
 }
@@ -533,14 +522,15 @@ void AlgoWFD_T1::sortBins()
         }
 
         // Then re-order the whole list of bins
+        countSort(bins.size());
         stable_sort(bins.begin(), bins.end(), bin_comparator_measure_decreasing);
     }
     else
     {
         // The measure of only one bin has changed, no need to perform complete sort
         // but the bubbling in BOTH directions is required, as it depends on the size measures
-        bubble_bin_down(bins.begin(), bins.end(), bin_comparator_measure_decreasing);
-        bubble_bin_up(bins.begin(), bins.end(), bin_comparator_measure_decreasing);
+        countBubble(bubble_bin_down(bins.begin(), bins.end(), bin_comparator_measure_decreasing));
+        countBubble(bubble_bin_up(bins.begin(), bins.end(), bin_comparator_measure_decreasing));
     }
 }
 
@@ -559,6 +549,7 @@ AlgoWFD_T2::AlgoWFD_T2(const std::string& algo_name, const Instance &instance,
 void AlgoWFD_T2::sortBins()
 {
     // The measure of all bins have been updated, need to re-order the whole list
+    countSort(bins.size());
     stable_sort(bins.begin(), bins.end(), bin_comparator_measure_decreasing);
 }
 
@@ -587,6 +578,241 @@ AlgoWF::AlgoWF(const std::string& algo_name, const Instance &instance,
 }
 
 
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+// Same loop as AlgoFit::solveInstance, with the flags known at compile time
+template<class Base, MEASURE M, bool DYNAMIC>
+int AlgoFitEngine<Base, M, DYNAMIC>::solveInstance(int hint_nb_bins)
+{
+    if (this->isSolved())
+    {
+        return this->getSolution(); // No need to solve twice
+    }
+    if (this->is_FFD_dynamic != DYNAMIC)
+    {
+        std::string s = "Algo " + this->name + " was not instantiated with the right dynamic weights flag";
+        throw std::runtime_error(s);
+    }
+    ScopedPhaseTimer phase_timer(this->timings, "solveInstance");
+    BinList& bins = this->bins;
+    if (hint_nb_bins > 0)
+    {
+        bins.reserve(hint_nb_bins); // Small memory optimisation
+    }
+
+    if (this->is_FFD_type)
+    {
+        // Compute item measures and renumber items in decreasing size
+        this->initItemOrder();
+    }
+
+    int total_items = this->instance.getNbItems();
+
+    // For all items in the list
+    auto curr_item_it = this->items.begin();
+    auto end_items_it = this->items.end();
+    while (curr_item_it != end_items_it)
+    {
+        this->checkCancelled();
+        Item* item = *curr_item_it;
+        const SizeList& sizes = item->getSizes();
+
+        bool allocated = false;
+        for (auto curr_bin_it = bins.begin(); curr_bin_it != bins.end(); ++curr_bin_it)
+        {
+            VP_COUNT(this->stats.bins_scanned, 1);
+            if (this->countFitCheck((*curr_bin_it)->doesItemFit(sizes)))
+            {
+                packItem(item, *curr_bin_it);
+                allocated = true;
+                break;
+            }
+        }
+
+        if (!allocated)
+        {
+            // The item did not fit in any bin, create a new one
+            Bin* bin = Base::createNewBin();
+
+            // This is a quick safe guard to avoid infinite loops and running out of memory
+            if ((int)bins.size() > total_items)
+            {
+                std::string s = "There seem to be a problem with algo " + this->name + " and instance " + this->instance.getName() + ", created more bins than items (" + std::to_string(bins.size()) + ").";
+                throw std::runtime_error(s);
+            }
+
+            packItem(item, bin);
+        }
+
+        // Advance to next item to pack
+        ++curr_item_it;
+
+        if constexpr (DYNAMIC)
+        {
+            // Update weights, item measures and order of remaining items
+            this->computeItemWeights(end_items_it - curr_item_it);
+            this->template setItemMeasures<M>(curr_item_it, end_items_it);
+            orderItems(curr_item_it, end_items_it);
+        }
+
+        // Bin measures have been updated when the item was added to a bin
+        orderBins();
+    }
+
+    this->solved = true;
+    return this->getSolution();
+}
+
+template<class Base, MEASURE M, bool DYNAMIC>
+void AlgoFitEngine<Base, M, DYNAMIC>::sortItems(ItemList::iterator first_item, ItemList::iterator end_it)
+{
+    orderItems(first_item, end_it);
+}
+
+template<class Base, MEASURE M, bool DYNAMIC>
+void AlgoFitEngine<Base, M, DYNAMIC>::computeItemMeasures(ItemList::iterator first_item, ItemList::iterator end_it)
+{
+    this->computeItemWeights(end_it - first_item);
+    this->template setItemMeasures<M>(first_item, end_it);
+}
+
+template<class Base, MEASURE M, bool DYNAMIC>
+void AlgoFitEngine<Base, M, DYNAMIC>::sortBins()
+{
+    orderBins();
+}
+
+template<class Base, MEASURE M, bool DYNAMIC>
+void AlgoFitEngine<Base, M, DYNAMIC>::addItemToBin(Item* item, Bin* bin)
+{
+    packItem(item, bin);
+}
+
+// Same as AlgoFFD::sortItems
+template<class Base, MEASURE M, bool DYNAMIC>
+void AlgoFitEngine<Base, M, DYNAMIC>::orderItems(ItemList::iterator first_item, ItemList::iterator end_it)
+{
+    auto compare_method = [this](Item* itema, Item* itemb) {
+        return (this->getItemMeasure(itema) > this->getItemMeasure(itemb));
+    };
+
+    if constexpr (DYNAMIC)
+    {
+        // Only need to bring forward the item of highest measure
+        this->countBubble(bubble_items_up(first_item, end_it, compare_method));
+    }
+    else
+    {
+        this->countSort(end_it - first_item);
+        stable_sort(first_item, end_it, compare_method);
+    }
+}
+
+// Same as the sortBins methods of AlgoBFD_T1, AlgoWFD_T1, AlgoBFD_T2 and AlgoWFD_T2
+template<class Base, MEASURE M, bool DYNAMIC>
+void AlgoFitEngine<Base, M, DYNAMIC>::orderBins()
+{
+    BinList& bins = this->bins;
+    auto comparator = (IS_WORST ? bin_comparator_measure_decreasing : bin_comparator_measure_increasing);
+    if constexpr (IS_T1)
+    {
+        if constexpr (DYNAMIC)
+        {
+            // The item weights have changed, need to re-compute all bin measures
+            for (Bin* bin : bins)
+            {
+                bin->setMeasure(utilBinMeasure<M>(this->weights_list, bin, this->dimensions));
+            }
+
+            // Then re-order the whole list of bins
+            this->countSort(bins.size());
+            stable_sort(bins.begin(), bins.end(), comparator);
+        }
+        else if constexpr (IS_WORST)
+        {
+            this->countBubble(bubble_bin_down(bins.begin(), bins.end(), bin_comparator_measure_decreasing));
+            this->countBubble(bubble_bin_up(bins.begin(), bins.end(), bin_comparator_measure_decreasing));
+        }
+        else
+        {
+            this->countBubble(bubble_bin_up(bins.begin(), bins.end(), bin_comparator_measure_increasing));
+            this->countBubble(bubble_bin_down(bins.begin(), bins.end(), bin_comparator_measure_decreasing));
+        }
+    }
+    else if constexpr (IS_T2)
+    {
+        // The measure of all bins have been updated, need to re-order the whole list
+        this->countSort(bins.size());
+        stable_sort(bins.begin(), bins.end(), comparator);
+    }
+}
+
+// Same as the addItemToBin methods of AlgoFFD, AlgoBFD_T1 and AlgoBFD_T2
+template<class Base, MEASURE M, bool DYNAMIC>
+void AlgoFitEngine<Base, M, DYNAMIC>::packItem(Item* item, Bin* bin)
+{
+    if constexpr (IS_T1 || IS_T2)
+    {
+        const FloatList& norm_sizes = item->getNormSizes();
+        BaseAlgo::addItemToBin(item, bin);
+
+        if constexpr (DYNAMIC)
+        {
+            // Update the total normalized size for dynamic item weights
+            for (int h = 0; h < this->dimensions; ++h)
+            {
+                this->total_norm_size[h] -= norm_sizes[h];
+            }
+        }
+
+        if constexpr (IS_T1)
+        {
+            // If dynamic weights are used, all bin measures will be updated by orderBins
+            if constexpr (!DYNAMIC)
+            {
+                bin->setMeasure(utilBinMeasure<M>(this->weights_list, bin, this->dimensions));
+            }
+        }
+        else
+        {
+            for (int h = 0; h < this->dimensions; ++h)
+            {
+                this->total_norm_residual_capacity[h] -= norm_sizes[h];
+            }
+            this->computeBinWeights();
+            this->template setBinMeasures<M>();
+        }
+    }
+    else
+    {
+        AlgoFFD::addItemToBin(item, bin);
+    }
+}
+
+// All combinations created by the algorithm registry
+#define INSTANTIATE_FIT_ENGINE(Base) \
+    template class AlgoFitEngine<Base, MEASURE::LINF, false>; \
+    template class AlgoFitEngine<Base, MEASURE::LINF, true>; \
+    template class AlgoFitEngine<Base, MEASURE::L1, false>; \
+    template class AlgoFitEngine<Base, MEASURE::L1, true>; \
+    template class AlgoFitEngine<Base, MEASURE::L2, false>; \
+    template class AlgoFitEngine<Base, MEASURE::L2, true>; \
+    template class AlgoFitEngine<Base, MEASURE::L2_LOAD, false>; \
+    template class AlgoFitEngine<Base, MEASURE::L2_LOAD, true>;
+
+INSTANTIATE_FIT_ENGINE(AlgoFFD)
+INSTANTIATE_FIT_ENGINE(AlgoBFD_T1)
+INSTANTIATE_FIT_ENGINE(AlgoWFD_T1)
+INSTANTIATE_FIT_ENGINE(AlgoBFD_T2)
+INSTANTIATE_FIT_ENGINE(AlgoBFD_T3)
+INSTANTIATE_FIT_ENGINE(AlgoWFD_T2)
+INSTANTIATE_FIT_ENGINE(AlgoWFD_T3)
+INSTANTIATE_FIT_ENGINE(AlgoBF)
+INSTANTIATE_FIT_ENGINE(AlgoWF)
+#undef INSTANTIATE_FIT_ENGINE
+
+
 /* ================================================ */
 /* ================================================ */
 /* ================================================ */
@@ -598,9 +824,15 @@ AlgoFFD_Lexico::AlgoFFD_Lexico(const std::string &algo_name, const Instance &ins
 
 void AlgoFFD_Lexico::sortItems(ItemList::iterator first_item, ItemList::iterator end_it)
 {
+    countSort(end_it - first_item);
     stable_sort(first_item, end_it, item_comparator_lexicographic_decreasing);
 }
 
+std::string AlgoFFD_Lexico::getItemOrderKey() const
+{
+    return "Lexico";
+}
+
 /* ================================================ */
 AlgoBFD_Lexico::AlgoBFD_Lexico(const std::string &algo_name, const Instance &instance):
     AlgoFFD_Lexico(algo_name, instance)
@@ -611,7 +843,7 @@ AlgoBFD_Lexico::AlgoBFD_Lexico(const std::string &algo_name, const Instance &ins
 void AlgoBFD_Lexico::sortBins()
 {
     // Only one bin has changed, need to bubble it to the front of the list
-    bubble_bin_up(bins.begin(), bins.end(), bin_comparator_lexicographic_increasing);
+    countBubble(bubble_bin_up(bins.begin(), bins.end(), bin_comparator_lexicographic_increasing));
 }
 
 /* ================================================ */
@@ -625,7 +857,7 @@ AlgoWFD_Lexico::AlgoWFD_Lexico(const std::string &algo_name, const Instance &ins
 void AlgoWFD_Lexico::sortBins()
 {
     // Only one bin has changed, need to bubble it to the back of the list
-    bubble_bin_down(bins.begin(), bins.end(), bin_comparator_lexicographic_decreasing);
+    countBubble(bubble_bin_down(bins.begin(), bins.end(), bin_comparator_lexicographic_decreasing));
 }
 
 
@@ -643,7 +875,11 @@ AlgoFFD_Rank::AlgoFFD_Rank(const std::string &algo_name, const Instance &instanc
 void AlgoFFD_Rank::sortItems(ItemList::iterator first_item, ItemList::iterator end_it)
 {
     //computeItemRanks(first_item, end_it);
-    stable_sort(first_item, end_it, item_comparator_measure_decreasing);
+    auto compare_method = [this](Item* itema, Item* itemb) {
+        return (getItemMeasure(itema) > getItemMeasure(itemb));
+    };
+    countSort(end_it - first_item);
+    stable_sort(first_item, end_it, compare_method);
 }
 
 void AlgoFFD_Rank::computeItemMeasures(ItemList::iterator first_item, ItemList::iterator end_it)
@@ -651,7 +887,7 @@ void AlgoFFD_Rank::computeItemMeasures(ItemList::iterator first_item, ItemList::
     // Reset all item measures to 0
     for(auto item_it = first_item; item_it != end_it; ++item_it)
     {
-        (*item_it)->setMeasure(0);
+        setItemMeasure(*item_it, 0);
     }
 
     for (int h = 0; h < dimensions; h++)
@@ -660,18 +896,28 @@ void AlgoFFD_Rank::computeItemMeasures(ItemList::iterator first_item, ItemList::
         auto compare_method = [h](Item* itema, Item* itemb) {
             return item_comparator_size_dim_increasing(itema, itemb, h);
         };
+        countSort(end_it - first_item);
         stable_sort(first_item, end_it, compare_method);
 
         // Then add to each item measure its rank in dimension h
         int rank = 0;
         for(auto item_it = first_item; item_it != end_it; ++item_it)
         {
-            (*item_it)->setMeasure((*item_it)->getMeasure() + rank);
+            setItemMeasure(*item_it, getItemMeasure(*item_it) + rank);
             rank++;
         }
     }
 }
 
+std::string AlgoFFD_Rank::getItemOrderKey() const
+{
+    if (is_FFD_dynamic)
+    {
+        return "";
+    }
+    return "Rank";
+}
+
 /* ================================================ */
 AlgoBFD_Rank::AlgoBFD_Rank(const std::string &algo_name, const Instance &instance,
                            const bool dynamic_items):
@@ -684,6 +930,7 @@ void AlgoBFD_Rank::sortBins()
 {
     computeBinRanks();
     // The aggregated rank of all bins may have changed, need to re-order the whole list
+    countSort(bins.size());
     stable_sort(bins.begin(), bins.end(), bin_comparator_measure_increasing);
 }
 
@@ -701,6 +948,7 @@ void AlgoBFD_Rank::computeBinRanks()
         auto compare_method = [h](Bin* bina, Bin* binb) {
             return bin_comparator_capacity_dim_increasing(bina, binb, h);
         };
+        countSort(bins.size());
         stable_sort(bins.begin(), bins.end(), compare_method);
 
         // Then add to each bin measure its rank in dimension h
@@ -723,6 +971,7 @@ void AlgoWFD_Rank::sortBins()
 {
     computeBinRanks();
     // The aggregated rank of all bins may have changed, need to re-order the whole list
+    countSort(bins.size());
     stable_sort(bins.begin(), bins.end(), bin_comparator_measure_decreasing);
 }
 
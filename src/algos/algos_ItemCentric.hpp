@@ -4,6 +4,8 @@
 #include "base_algo.hpp"
 #include "weights_measures_scores.hpp"
 
+#include <type_traits>
+
 using namespace vectorpack;
 
 // Base class of AlgoFit tailored for vector bin packing
@@ -23,6 +25,11 @@ protected:
     virtual void sortItems(ItemList::iterator first_item, ItemList::iterator end_it);
     virtual void computeItemMeasures(ItemList::iterator first_item, ItemList::iterator end_it);
 
+    // Compute measures and sort the whole list of items before packing
+    // The order is shared through the instance cache when getItemOrderKey is not empty
+    virtual void initItemOrder();
+    virtual std::string getItemOrderKey() const;
+
 protected:
     bool is_FFD_type; // Whether to compute item measures and sort items
     bool is_FFD_dynamic; // Whether to re-compute weights, item measures and re-order items after each packing
@@ -54,9 +61,15 @@ public:
 protected:
     virtual void sortItems(ItemList::iterator first_item, ItemList::iterator end_it);
     virtual void computeItemMeasures(ItemList::iterator first_item, ItemList::iterator end_it);
+    virtual void initItemOrder();
+    virtual std::string getItemOrderKey() const;
     virtual void addItemToBin(Item* item, Bin* bin);
     virtual Bin* createNewBin(); // Open a new empty bin
 
+    void computeItemWeights(int nb_items);
+    template<MEASURE M>
+    void setItemMeasures(ItemList::iterator first_item, ItemList::iterator end_it); // With the current weights
+
     const MEASURE size_measure;
     const WEIGHT weight;
     FloatList weights_list; // The list of computed weights
@@ -99,6 +112,9 @@ protected:
     virtual void addItemToBin(Item* item, Bin* bin);
 
     void updateBinMeasures();
+    void computeBinWeights();
+    template<MEASURE M>
+    void setBinMeasures(); // With the current bin weights
 
     FloatList total_norm_residual_capacity; // The list of residual capacity of all bins
     FloatList bin_weights_list; // The list of computed weights for bins
@@ -170,6 +186,40 @@ public:
 };
 
 
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+// Engine of the measure-based algorithms above (FFD, BFD, WFD, BF and WF variants)
+// Packs exactly as Base, but the measure and whether item weights are dynamic are template
+// parameters: the loops over items and bins call no virtual method and do not switch on the measure
+// DYNAMIC must be the is_FFD_dynamic flag set by the constructor of Base (also true for ratio weights)
+// Instantiated in algos_ItemCentric.cpp for each Base and measure, created by the algorithm registry
+// (the engines of algos_OneDim.hpp and algos_TwoDim.hpp derive from it to fall back on its packing loop)
+template<class Base, MEASURE M, bool DYNAMIC>
+class AlgoFitEngine : public Base
+{
+public:
+    using Base::Base;
+
+    virtual int solveInstance(int hint_nb_bins = 0);
+
+protected:
+    static const bool IS_T1 = std::is_base_of<AlgoBFD_T1, Base>::value; // Bin measures updated one by one
+    static const bool IS_T2 = std::is_base_of<AlgoBFD_T2, Base>::value; // Bin measures updated all together
+    static const bool IS_WORST = std::is_base_of<AlgoWFD_T1, Base>::value || std::is_base_of<AlgoWFD_T2, Base>::value;
+
+    virtual void sortItems(ItemList::iterator first_item, ItemList::iterator end_it);
+    virtual void computeItemMeasures(ItemList::iterator first_item, ItemList::iterator end_it);
+    virtual void sortBins();
+    virtual void addItemToBin(Item* item, Bin* bin);
+
+    // Non-virtual versions called by the packing loop
+    void orderItems(ItemList::iterator first_item, ItemList::iterator end_it);
+    void orderBins();
+    void packItem(Item* item, Bin* bin);
+};
+
+
 
 
 /* ================================================ */
@@ -182,6 +232,7 @@ public:
 
 protected:
     virtual void sortItems(ItemList::iterator first_item, ItemList::iterator end_it);
+    virtual std::string getItemOrderKey() const;
 };
 
 class AlgoBFD_Lexico : public AlgoFFD_Lexico
@@ -214,6 +265,7 @@ public:
 protected:
     virtual void sortItems(ItemList::iterator first_item, ItemList::iterator end_it);
     virtual void computeItemMeasures(ItemList::iterator first_item, ItemList::iterator end_it);
+    virtual std::string getItemOrderKey() const;
 };
 
 class AlgoBFD_Rank : public AlgoFFD_Rank
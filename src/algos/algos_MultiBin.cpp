@@ -52,11 +52,12 @@ void AlgoPairing::updateScores(Bin* bin, ItemList::iterator first_item, ItemList
 
 void AlgoPairing::resetAlgo()
 {
-    clearSolution();
-
-    total_norm_size.clear();
-    total_norm_size = FloatList(dimensions, 0.0);
+    // Bins and buffers are kept allocated between two calls to trySolve
+    recycleSolution();
 
+    // The probes re-order the items: the sum runs in their current order, and not in the order
+    // of Instance::getTotalNormSizes, as the weights of the next probe depend on its rounding
+    std::fill(total_norm_size.begin(), total_norm_size.end(), 0.0);
     for(Item * item : items)
     {
         for (int h = 0; h < dimensions; ++h)
@@ -67,14 +68,16 @@ void AlgoPairing::resetAlgo()
 
     if ((score == SCORE::NORM_DOT_PRODUCT) || is_ratio_weight || use_bin_weights)
     {
-        total_norm_residual_capacity.clear();
-        total_norm_residual_capacity = FloatList(dimensions, 0.0);
+        std::fill(total_norm_residual_capacity.begin(), total_norm_residual_capacity.end(), 0.0);
     }
 }
 
 
 bool AlgoPairing::trySolve(int nb_bins)
 {
+    ScopedPhaseTimer phase_timer(timings, "trySolve");
+    VP_COUNT(stats.probes, 1);
+
     if (nb_bins < 0)
     {
         std::string s("Trying to solve instance with negative number of bins");
@@ -105,8 +108,11 @@ bool AlgoPairing::trySolve(int nb_bins)
     if (store_scores)
     {
         // Initialize the score for each item-bin pair
-        bin_item_scores.clear();
-        bin_item_scores.resize(nb_bins, std::vector<float>(nb_items, 0.0));
+        // Score rows of previous calls are kept, all their values are overwritten below
+        if ((int)bin_item_scores.size() < nb_bins)
+        {
+            bin_item_scores.resize(nb_bins, std::vector<float>(nb_items, 0.0));
+        }
         for (Bin* bin : bins)
         {
             updateScores(bin, items.begin(), items.end());
@@ -127,6 +133,16 @@ bool AlgoPairing::packItems(BinList::iterator start_bin_it)
 
     while(first_item_it != end_items_it) // While there are items to pack
     {
+        checkCancelled();
+
+        // Each step scans all item-bin pairs, the clock can be read every time
+        if (isDeadlineExpired())
+        {
+            // Out of time, the probe is abandoned
+            first_remaining_item = first_item_it;
+            return false;
+        }
+
         // Compute maximum score for each pair of item-bin
         auto max_score_item_it = end_items_it;
         auto max_score_bin_it = end_bins_it;
@@ -138,7 +154,8 @@ bool AlgoPairing::packItems(BinList::iterator start_bin_it)
             // For each bin
             for(auto curr_bin_it = start_bin_it; curr_bin_it != end_bins_it; ++curr_bin_it)
             {
-                if ((*curr_bin_it)->doesItemFit((*curr_item_it)->getSizes()))
+                VP_COUNT(stats.bins_scanned, 1);
+                if (countFitCheck((*curr_bin_it)->doesItemFit((*curr_item_it)->getSizes())))
                 {
                     float score;
                     if (!store_scores)
@@ -220,6 +237,9 @@ AlgoPairing_Increment::AlgoPairing_Increment(
 
 int AlgoPairing_Increment::solveInstanceMultiBin(int LB, int UB)
 {
+    ScopedPhaseTimer phase_timer(timings, "solveInstanceMultiBin");
+    startDeadline();
+
     int bin_increment = 1; // Default
     if (bin_increment_percent > 0)
     {
@@ -234,7 +254,7 @@ int AlgoPairing_Increment::solveInstanceMultiBin(int LB, int UB)
     int target_bins = LB;
     bool sol_found = trySolve(target_bins);
     bool last_try = false;
-    while (!sol_found && !last_try)
+    while (!sol_found && !last_try && !isDeadlineExpired())
     {
         // There are remaining items to pack
         // But no bin can accommodate an item anymore
@@ -251,6 +271,12 @@ int AlgoPairing_Increment::solveInstanceMultiBin(int LB, int UB)
         sol_found = trySolve(target_bins);
     }
 
+    if (!sol_found && deadline_expired)
+    {
+        // No feasible solution found in time
+        return solveFallbackFF();
+    }
+
     int answer = target_bins;
     if (!sol_found)
     {
@@ -287,9 +313,17 @@ void AlgoPairing_BinSearch::updateBestBins(const BinList &new_bins)
 // Implements true Binary Search
 int AlgoPairing_BinSearch::solveInstanceMultiBin(int LB, int UB)
 {
+    ScopedPhaseTimer phase_timer(timings, "solveInstanceMultiBin");
+    startDeadline();
+
     // First, try to find a solution with UB
     if (!trySolve(UB))
     {
+        if (deadline_expired)
+        {
+            // No feasible solution found in time
+            return solveFallbackFF();
+        }
         // If no solution found, no need to continue the search
         return -1;
     }
@@ -301,6 +335,12 @@ int AlgoPairing_BinSearch::solveInstanceMultiBin(int LB, int UB)
     // Then iteratively try to improve on the solution
     while (LB < UB)
     {
+        if (isDeadlineExpired())
+        {
+            // Out of time, keep the best solution found so far
+            converged = false;
+            break;
+        }
         target_bins = std::floor((float)(LB + UB) / 2.0);
 
         if (trySolve(target_bins))
@@ -309,6 +349,12 @@ int AlgoPairing_BinSearch::solveInstanceMultiBin(int LB, int UB)
             UB = target_bins;
             updateBestBins(getBinsCopy());
         }
+        else if (deadline_expired)
+        {
+            // The probe was abandoned, nothing can be said about target_bins
+            converged = false;
+            break;
+        }
         else
         {
             // Target too low, update LB
@@ -317,6 +363,7 @@ int AlgoPairing_BinSearch::solveInstanceMultiBin(int LB, int UB)
     }
 
     setSolution(best_bins);
+    best_bins.clear(); // The best bins are now owned by the solution
     return UB;
 }
 
@@ -352,11 +399,12 @@ void AlgoWFDm::createNewBins(int nb_bins)
 
 void AlgoWFDm::resetAlgo()
 {
-    clearSolution();
-
-    total_norm_size.clear();
-    total_norm_size = FloatList(dimensions, 0.0);
+    // Bins and buffers are kept allocated between two calls to trySolve
+    recycleSolution();
 
+    // The probes re-order the items: the sum runs in their current order, and not in the order
+    // of Instance::getTotalNormSizes, as the weights of the next probe depend on its rounding
+    std::fill(total_norm_size.begin(), total_norm_size.end(), 0.0);
     for(Item * item : items)
     {
         for (int h = 0; h < dimensions; ++h)
@@ -367,13 +415,15 @@ void AlgoWFDm::resetAlgo()
 
     if (is_ratio_weight)
     {
-        total_norm_residual_capacity.clear();
-        total_norm_residual_capacity = FloatList(dimensions, 0.0);
+        std::fill(total_norm_residual_capacity.begin(), total_norm_residual_capacity.end(), 0.0);
     }
 }
 
 bool AlgoWFDm::trySolve(int nb_bins)
 {
+    ScopedPhaseTimer phase_timer(timings, "trySolve");
+    VP_COUNT(stats.probes, 1);
+
     if (nb_bins < 0)
     {
         std::string s("Trying to solve instance with negative number of bins");
@@ -386,8 +436,8 @@ bool AlgoWFDm::trySolve(int nb_bins)
     if (is_FFD_type)
     {
         // Weights are computed as well
-        computeItemMeasures(items.begin(), items.end());
-        sortItems(items.begin(), items.end());
+        // With static weights, the order is computed once and retrieved from the instance cache
+        initItemOrder();
     }
     else
     {
@@ -421,12 +471,21 @@ bool AlgoWFDm::packItems(BinList::iterator start_bin_it)
     auto end_items_it = items.end();
     while(curr_item_it != end_items_it)
     {
+        checkCancelled();
+        if (checkDeadline())
+        {
+            // Out of time, the probe is abandoned
+            first_remaining_item = curr_item_it;
+            return false;
+        }
+
         Item * item = *curr_item_it;
 
         auto curr_bin_it = start_bin_it;
         allocated = false;
         while ((!allocated) && (curr_bin_it != bins.end()))
         {
+            VP_COUNT(stats.bins_scanned, 1);
             if (checkItemToBin(item, *curr_bin_it))
             {
                 addItemToBin(item, *curr_bin_it);
@@ -474,14 +533,15 @@ void AlgoWFDm::sortBins(BinList::iterator first_bin, BinList::iterator last_bin)
         }
 
         // Then re-order the whole list of bins
+        countSort(last_bin - first_bin);
         stable_sort(first_bin, last_bin, bin_comparator_measure_decreasing);
     }
     else
     {
         // The measure of only one bin has changed, no need to perform complete sort
         // but the bubbling in BOTH directions is required, as it depends on the size measures
-        bubble_bin_down(first_bin, last_bin, bin_comparator_measure_decreasing);
-        bubble_bin_up(first_bin, last_bin, bin_comparator_measure_increasing);
+        countBubble(bubble_bin_down(first_bin, last_bin, bin_comparator_measure_decreasing));
+        countBubble(bubble_bin_up(first_bin, last_bin, bin_comparator_measure_increasing));
     }
 }
 
@@ -505,6 +565,9 @@ int AlgoWFDm_Increment::solveInstanceMultiBin(int LB, int UB)
     //!\\ This should be a strict copy of the same method of AlgoPairing_Increment
     //!\\
 
+    ScopedPhaseTimer phase_timer(timings, "solveInstanceMultiBin");
+    startDeadline();
+
     int bin_increment = 1; // Default
     if (bin_increment_percent > 0)
     {
@@ -519,7 +582,7 @@ int AlgoWFDm_Increment::solveInstanceMultiBin(int LB, int UB)
     int target_bins = LB;
     bool sol_found = trySolve(target_bins);
     bool last_try = false;
-    while (!sol_found && !last_try)
+    while (!sol_found && !last_try && !isDeadlineExpired())
     {
         // There are remaining items to pack
         // But no bin can accommodate an item anymore
@@ -536,6 +599,12 @@ int AlgoWFDm_Increment::solveInstanceMultiBin(int LB, int UB)
         sol_found = trySolve(target_bins);
     }
 
+    if (!sol_found && deadline_expired)
+    {
+        // No feasible solution found in time
+        return solveFallbackFF();
+    }
+
     int answer = target_bins;
     if (!sol_found)
     {
@@ -575,9 +644,17 @@ int AlgoWFDm_BinSearch::solveInstanceMultiBin(int LB, int UB)
     //!\\ This should be a strict copy of the same method of AlgoPairing_BinSearch
     //!\\
 
+    ScopedPhaseTimer phase_timer(timings, "solveInstanceMultiBin");
+    startDeadline();
+
     // First, try to find a solution with UB
     if (!trySolve(UB))
     {
+        if (deadline_expired)
+        {
+            // No feasible solution found in time
+            return solveFallbackFF();
+        }
         // If no solution found, no need to continue the search
         return -1;
     }
@@ -589,6 +666,12 @@ int AlgoWFDm_BinSearch::solveInstanceMultiBin(int LB, int UB)
     // Then iteratively try to improve on the solution
     while (LB < UB)
     {
+        if (isDeadlineExpired())
+        {
+            // Out of time, keep the best solution found so far
+            converged = false;
+            break;
+        }
         target_bins = std::floor((float)(LB + UB) / 2.0);
 
         if (trySolve(target_bins))
@@ -597,6 +680,12 @@ int AlgoWFDm_BinSearch::solveInstanceMultiBin(int LB, int UB)
             UB = target_bins;
             updateBestBins(getBinsCopy());
         }
+        else if (deadline_expired)
+        {
+            // The probe was abandoned, nothing can be said about target_bins
+            converged = false;
+            break;
+        }
         else
         {
             // Target too low, update LB
@@ -605,6 +694,7 @@ int AlgoWFDm_BinSearch::solveInstanceMultiBin(int LB, int UB)
     }
 
     setSolution(best_bins);
+    best_bins.clear(); // The best bins are now owned by the solution
     return UB;
 }
 
@@ -630,14 +720,15 @@ void AlgoBFDm_Increment::sortBins(BinList::iterator first_bin, BinList::iterator
         }
 
         // Then re-order the whole list of bins
+        countSort(last_bin - first_bin);
         stable_sort(first_bin, last_bin, bin_comparator_measure_increasing);
     }
     else
     {
         // The measure of only one bin has changed, no need to perform complete sort
         // but the bubbling in BOTH directions is required, as it depends on the size measures
-        bubble_bin_up(first_bin, last_bin, bin_comparator_measure_increasing);
-        bubble_bin_down(first_bin, last_bin, bin_comparator_measure_decreasing);
+        countBubble(bubble_bin_up(first_bin, last_bin, bin_comparator_measure_increasing));
+        countBubble(bubble_bin_down(first_bin, last_bin, bin_comparator_measure_decreasing));
     }
 }
 
@@ -663,13 +754,14 @@ void AlgoBFDm_BinSearch::sortBins(BinList::iterator first_bin, BinList::iterator
         }
 
         // Then re-order the whole list of bins
+        countSort(last_bin - first_bin);
         stable_sort(first_bin, last_bin, bin_comparator_measure_increasing);
     }
     else
     {
         // The measure of only one bin has changed, no need to perform complete sort
         // but the bubbling in BOTH directions is required, as it depends on the size measures
-        bubble_bin_up(first_bin, last_bin, bin_comparator_measure_increasing);
-        bubble_bin_down(first_bin, last_bin, bin_comparator_measure_decreasing);
+        countBubble(bubble_bin_up(first_bin, last_bin, bin_comparator_measure_increasing));
+        countBubble(bubble_bin_down(first_bin, last_bin, bin_comparator_measure_decreasing));
     }
 }
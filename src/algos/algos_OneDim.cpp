@@ -0,0 +1,297 @@
+#include "algos_OneDim.hpp"
+
+#include <algorithm> // For max and fill
+#include <cmath> // For isfinite
+#include <limits>
+#include <stdexcept> // For throwing stuff
+
+
+FirstFitTree::FirstFitTree(int max_bins):
+    nb_leaves(1)
+{
+    while (nb_leaves < max_bins)
+    {
+        nb_leaves *= 2;
+    }
+    // Bins not created yet never fit
+    tree.assign(2 * nb_leaves, std::numeric_limits<int>::min());
+}
+
+int FirstFitTree::findFirst(int size, AlgoStats& stats) const
+{
+    VP_COUNT(stats.index_nodes, 1);
+    if (tree[1] < size)
+    {
+        return -1;
+    }
+    // Go down to the leftmost leaf large enough
+    int node = 1;
+    while (node < nb_leaves)
+    {
+        VP_COUNT(stats.index_nodes, 1);
+        node = 2 * node;
+        if (tree[node] < size)
+        {
+            node += 1;
+        }
+    }
+    return node - nb_leaves;
+}
+
+void FirstFitTree::setResidual(int bin_index, int residual)
+{
+    int node = nb_leaves + bin_index;
+    tree[node] = residual;
+    for (node /= 2; node >= 1; node /= 2)
+    {
+        tree[node] = std::max(tree[2 * node], tree[2 * node + 1]);
+    }
+}
+
+
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+static void checkOneDim(const std::string& algo_name, int dimensions)
+{
+    if (dimensions != 1)
+    {
+        std::string s = "Algo " + algo_name + " was instantiated with the one-dimensional engine for " + std::to_string(dimensions) + " dimensions";
+        throw std::runtime_error(s);
+    }
+}
+
+// Same solution as AlgoFit::solveInstance for AlgoFF
+int AlgoFF_1D::solveInstance(int hint_nb_bins)
+{
+    if (isSolved())
+    {
+        return getSolution(); // No need to solve twice
+    }
+    checkOneDim(name, dimensions);
+    ScopedPhaseTimer phase_timer(timings, "solveInstance");
+    if (hint_nb_bins > 0)
+    {
+        bins.reserve(hint_nb_bins); // Small memory optimisation
+    }
+
+    // The bins are created at the end of the list, the bin of index i in the tree is bins[i]
+    FirstFitTree tree(items.size()); // At most one bin per item
+    for (Item* item : items)
+    {
+        checkCancelled();
+        int index = countIndexQuery(tree.findFirst(item->getSizes()[0], stats));
+        Bin* bin = (index >= 0) ? bins[index] : createNewBin();
+        addItemToBin(item, bin);
+        tree.setResidual(bin->getId(), bin->getAvailableCapDim(0));
+    }
+
+    solved = true;
+    return getSolution();
+}
+
+
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+template<class Base, MEASURE M>
+int AlgoFitEngine1D<Base, M>::solveInstance(int hint_nb_bins)
+{
+    if (this->isSolved())
+    {
+        return this->getSolution(); // No need to solve twice
+    }
+    checkOneDim(this->name, this->dimensions);
+
+    bool packed = true;
+    {
+        ScopedPhaseTimer phase_timer(this->timings, "solveInstance");
+        if (hint_nb_bins > 0)
+        {
+            this->bins.reserve(hint_nb_bins); // Small memory optimisation
+        }
+
+        if (this->is_FFD_type)
+        {
+            // Compute item measures and renumber items in decreasing size
+            this->initItemOrder();
+        }
+
+        if constexpr (IS_FIRST_FIT)
+        {
+            packFirstFit();
+        }
+        else
+        {
+            // The bins are created at the end of the list while packing, and ordered afterwards
+            bool created_at_end = this->create_bins_at_end;
+            this->create_bins_at_end = true;
+            packed = packOrdered(created_at_end);
+            this->create_bins_at_end = created_at_end;
+        }
+    }
+
+    if (!packed)
+    {
+        // Start again with the list of bins of the general engine
+        this->clearSolution();
+        if constexpr (General::IS_T2)
+        {
+            std::fill(this->total_norm_residual_capacity.begin(), this->total_norm_residual_capacity.end(), 0.0f);
+        }
+        return General::solveInstance(hint_nb_bins);
+    }
+
+    this->solved = true;
+    return this->getSolution();
+}
+
+template<class Base, MEASURE M>
+void AlgoFitEngine1D<Base, M>::packFirstFit()
+{
+    BinList& bins = this->bins;
+    FirstFitTree tree(this->items.size()); // At most one bin per item
+    for (Item* item : this->items)
+    {
+        this->checkCancelled();
+        int index = this->countIndexQuery(tree.findFirst(item->getSizes()[0], this->stats));
+        Bin* bin = (index >= 0) ? bins[index] : Base::createNewBin();
+        this->packItem(item, bin);
+        tree.setResidual(bin->getId(), bin->getAvailableCapDim(0));
+    }
+}
+
+template<class Base, MEASURE M>
+bool AlgoFitEngine1D<Base, M>::packOrdered(bool created_at_end)
+{
+    BinList& bins = this->bins;
+    const int capacity = this->bin_max_capacities[0];
+    if ((capacity >= MAX_EXACT_CAPACITY) || (this->instance.getMaxSizes()[0] > capacity))
+    {
+        return false;
+    }
+    if constexpr (General::IS_T1)
+    {
+        // The bin measures use the static item weights
+        if (!isOrderingWeight(this->weights_list[0]))
+        {
+            return false;
+        }
+    }
+
+    // Bins in the order of the list of the general engine: a bin whose residual capacity decreases
+    // goes after the bins with the same residual capacity in increasing orders, and before them
+    // in decreasing orders. A new bin goes after them if created at the end of the list
+    std::map<BinKey, Bin*> ordered_bins;
+    std::vector<BinKey> bin_keys; // Indexed by bin id
+    int step = 0;
+    for (Item* item : this->items)
+    {
+        this->checkCancelled();
+        ++step;
+        const int size = item->getSizes()[0];
+
+        Bin* bin = nullptr;
+        if (!ordered_bins.empty())
+        {
+            if constexpr (IS_INCREASING)
+            {
+                // First bin large enough
+                auto bin_it = ordered_bins.lower_bound(BinKey(size, std::numeric_limits<int>::min()));
+                if (bin_it != ordered_bins.end())
+                {
+                    bin = bin_it->second;
+                }
+            }
+            else if (-ordered_bins.begin()->first.first >= size)
+            {
+                // The first bin has the largest residual capacity
+                bin = ordered_bins.begin()->second;
+            }
+        }
+        this->countIndexQuery((bin != nullptr) ? bin->getId() : -1);
+
+        if (bin == nullptr)
+        {
+            bin = Base::createNewBin();
+            BaseAlgo::addItemToBin(item, bin);
+            bin_keys.push_back(makeKey(bin, (created_at_end ? step : -step)));
+            ordered_bins.emplace(bin_keys.back(), bin);
+        }
+        else if (size == 0)
+        {
+            BaseAlgo::addItemToBin(item, bin); // Same measure, the bin keeps its place
+        }
+        else
+        {
+            BinKey& key = bin_keys[bin->getId()];
+            ordered_bins.erase(key);
+            BaseAlgo::addItemToBin(item, bin);
+            key = makeKey(bin, (IS_INCREASING ? step : -step));
+            ordered_bins.emplace(key, bin);
+        }
+
+        if constexpr (General::IS_T2)
+        {
+            // Same bin weights as the general engine
+            this->total_norm_residual_capacity[0] -= item->getNormSizeDim(0);
+            this->computeBinWeights();
+
+            // Otherwise the general engine keeps the list as it is, which is only
+            // the same order if all bins have the same residual capacity
+            if (!isOrderingWeight(this->bin_weights_list[0])
+                && (ordered_bins.begin()->first.first != ordered_bins.rbegin()->first.first))
+            {
+                return false;
+            }
+        }
+    }
+
+    // Same list of bins and bin measures as the general engine
+    bins.clear();
+    for (const auto& entry : ordered_bins)
+    {
+        Bin* bin = entry.second;
+        if constexpr (General::IS_T1)
+        {
+            bin->setMeasure(utilBinMeasure<M>(this->weights_list, bin, 1));
+        }
+        else if constexpr (General::IS_T2)
+        {
+            bin->setMeasure(utilBinMeasure<M>(this->bin_weights_list, bin, 1));
+        }
+        bins.push_back(bin);
+    }
+    return true;
+}
+
+template<class Base, MEASURE M>
+typename AlgoFitEngine1D<Base, M>::BinKey AlgoFitEngine1D<Base, M>::makeKey(Bin* bin, int tie) const
+{
+    int residual = bin->getAvailableCapDim(0);
+    return BinKey((IS_INCREASING ? residual : -residual), tie);
+}
+
+template<class Base, MEASURE M>
+bool AlgoFitEngine1D<Base, M>::isOrderingWeight(float weight)
+{
+    // The measures of all bins are multiplied by the same weight
+    return (weight > 0.0f) && std::isfinite(weight);
+}
+
+// All combinations created by the algorithm registry
+#define INSTANTIATE_FIT_ENGINE_1D(Base) \
+    template class AlgoFitEngine1D<Base, MEASURE::LINF>; \
+    template class AlgoFitEngine1D<Base, MEASURE::L1>; \
+    template class AlgoFitEngine1D<Base, MEASURE::L2>; \
+    template class AlgoFitEngine1D<Base, MEASURE::L2_LOAD>;
+
+INSTANTIATE_FIT_ENGINE_1D(AlgoFFD)
+INSTANTIATE_FIT_ENGINE_1D(AlgoWFD_T1)
+INSTANTIATE_FIT_ENGINE_1D(AlgoBFD_T2)
+INSTANTIATE_FIT_ENGINE_1D(AlgoBFD_T3)
+INSTANTIATE_FIT_ENGINE_1D(AlgoWFD_T2)
+INSTANTIATE_FIT_ENGINE_1D(AlgoWFD_T3)
+INSTANTIATE_FIT_ENGINE_1D(AlgoBF)
+INSTANTIATE_FIT_ENGINE_1D(AlgoWF)
+#undef INSTANTIATE_FIT_ENGINE_1D
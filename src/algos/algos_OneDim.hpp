@@ -0,0 +1,97 @@
+#ifndef ALGOS_ONEDIM_HPP
+#define ALGOS_ONEDIM_HPP
+
+#include "algos_ItemCentric.hpp"
+
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace vectorpack;
+
+// Engines of the item-centric algorithms for one-dimensional instances
+// Instead of scanning and re-ordering the whole list of bins for each item, the bins are
+// indexed by their residual capacity and each item is placed in O(log m)
+// They give the same solutions as the general algorithms, and are chosen by the algorithm
+// registry when the instance has one dimension
+
+
+// Max segment tree over the residual capacities of the bins, in their order of creation
+class FirstFitTree
+{
+public:
+    FirstFitTree(int max_bins);
+
+    // Lowest bin index with a residual capacity of at least size, -1 if none
+    // The nodes visited are counted in stats.index_nodes
+    int findFirst(int size, AlgoStats& stats) const;
+    void setResidual(int bin_index, int residual);
+
+protected:
+    int nb_leaves;
+    std::vector<int> tree; // tree[1] is the root, the residual of bin i is in tree[nb_leaves + i]
+};
+
+
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+// First Fit, with the bins in a FirstFitTree
+class AlgoFF_1D final : public AlgoFF
+{
+public:
+    using AlgoFF::AlgoFF;
+
+    virtual int solveInstance(int hint_nb_bins = 0);
+};
+
+
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+// Engine of FFD, BFD-T2, BFD-T3, BF, WFD-T1, WFD-T2, WFD-T3 and WF with static item weights
+// With one dimension, the measure of a bin only depends on its residual capacity as long as the
+// bin weight is positive: the list of bins of the general engine is then sorted by residual
+// capacity, and its ties are kept in an order which only depends on when the bins last changed
+// (stable sorts and bubbling). The bins are kept in a map in the order of that list:
+// - FFD looks for the first bin in order of creation in a FirstFitTree
+// - Best Fit orders (increasing residual capacity) look for the first bin large enough
+// - Worst Fit orders (decreasing residual capacity) only check the first bin
+// The general engine is used instead when the bins may not be ordered by residual capacity:
+// a bin weight which is not positive, items larger than the bins, or bins so large that
+// the measures of different residual capacities may be rounded to the same float
+// Instantiated in algos_OneDim.cpp for each Base and measure
+template<class Base, MEASURE M>
+class AlgoFitEngine1D final : public AlgoFitEngine<Base, M, false>
+{
+public:
+    using AlgoFitEngine<Base, M, false>::AlgoFitEngine;
+
+    virtual int solveInstance(int hint_nb_bins = 0);
+
+protected:
+    using General = AlgoFitEngine<Base, M, false>;
+    using BinKey = std::pair<int, int>; // Residual capacity (negated for decreasing orders), then tie order
+
+    static const bool IS_FIRST_FIT = std::is_same<Base, AlgoFFD>::value;
+    // Whether the list of bins is in increasing residual capacity (L2_LOAD measures the load of the bins)
+    static const bool IS_INCREASING = ((M != MEASURE::L2_LOAD) != General::IS_WORST);
+    static const int MAX_EXACT_CAPACITY = (1 << 22); // Measures of different residual capacities differ below
+
+    void packFirstFit();
+    bool packOrdered(bool created_at_end); // False if the bins are not ordered by residual capacity
+
+    BinKey makeKey(Bin* bin, int tie) const;
+    static bool isOrderingWeight(float weight); // Whether the measure orders the bins with this weight
+};
+
+// BFD-T1 re-orders its bins by bubbling the changed bin in both directions, which moves the
+// bin of smallest measure to the end of the list: it is not exactly Best Fit, and keeps the general engine
+template<class Base>
+constexpr bool hasOneDimEngine()
+{
+    return !std::is_same<Base, AlgoBFD_T1>::value;
+}
+
+#endif // ALGOS_ONEDIM_HPP
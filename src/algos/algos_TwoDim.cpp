@@ -0,0 +1,342 @@
+#include "algos_TwoDim.hpp"
+
+#include <algorithm> // For sort, unique and upper_bound
+#include <cmath> // For isfinite
+#include <stdexcept> // For throwing stuff
+
+
+DominanceIndex::DominanceIndex(const SizeList& x_thresholds, const SizeList& y_thresholds, int max_points):
+    x_thresholds(x_thresholds),
+    y_thresholds(y_thresholds),
+    nb_leaves(1),
+    point_x_ranks(max_points, -1),
+    point_y_ranks(max_points, -1),
+    random_state(2463534242u)
+{
+    for (SizeList* thresholds : {&this->x_thresholds, &this->y_thresholds})
+    {
+        std::sort(thresholds->begin(), thresholds->end());
+        thresholds->erase(std::unique(thresholds->begin(), thresholds->end()), thresholds->end());
+    }
+    // The ranks of x are in [0, number of thresholds]
+    while (nb_leaves <= (int)this->x_thresholds.size())
+    {
+        nb_leaves *= 2;
+    }
+    roots.assign(2 * nb_leaves, -1);
+}
+
+void DominanceIndex::insert(int point, int x, int y, const Key& key)
+{
+    int x_rank = rankOf(x_thresholds, x);
+    int y_rank = rankOf(y_thresholds, y);
+    point_x_ranks[point] = x_rank;
+    point_y_ranks[point] = y_rank;
+
+    // In the treaps of the leaf of x and of all its ancestors
+    std::pair<int, int> position(y_rank, point);
+    for (int tree_node = nb_leaves + x_rank; tree_node >= 1; tree_node /= 2)
+    {
+        int node = newNode(point, y_rank, key);
+        int left, right;
+        split(roots[tree_node], position, left, right);
+        roots[tree_node] = merge(merge(left, node), right);
+    }
+}
+
+void DominanceIndex::erase(int point)
+{
+    std::pair<int, int> position(point_y_ranks[point], point);
+    std::pair<int, int> next_position(point_y_ranks[point], point + 1);
+    for (int tree_node = nb_leaves + point_x_ranks[point]; tree_node >= 1; tree_node /= 2)
+    {
+        int left, middle, right;
+        split(roots[tree_node], position, left, right);
+        split(right, next_position, middle, right);
+        free_nodes.push_back(middle); // The node of the point
+        roots[tree_node] = merge(left, right);
+    }
+    point_x_ranks[point] = -1;
+    point_y_ranks[point] = -1;
+}
+
+int DominanceIndex::findMin(int a, int b, AlgoStats& stats) const
+{
+    // Since a is a threshold, x >= a if and only if the rank of x is at least the rank of a
+    int y_rank = rankOf(y_thresholds, b);
+    Key best_key;
+    int best_point = -1;
+    // Canonical nodes of the segment tree covering the ranks of x from the rank of a
+    int low = nb_leaves + rankOf(x_thresholds, a);
+    int high = 2 * nb_leaves;
+    for (; low < high; low /= 2, high /= 2)
+    {
+        if (low & 1)
+        {
+            findMinIn(roots[low++], y_rank, best_key, best_point, stats);
+        }
+        if (high & 1)
+        {
+            findMinIn(roots[--high], y_rank, best_key, best_point, stats);
+        }
+    }
+    return best_point;
+}
+
+int DominanceIndex::rankOf(const SizeList& thresholds, int value)
+{
+    return std::upper_bound(thresholds.begin(), thresholds.end(), value) - thresholds.begin();
+}
+
+int DominanceIndex::newNode(int point, int y_rank, const Key& key)
+{
+    // Xorshift, the priorities only need to look random
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    TreapNode tree_node = {std::make_pair(y_rank, point), key, key, point, random_state, -1, -1};
+
+    if (free_nodes.empty())
+    {
+        nodes.push_back(tree_node);
+        return nodes.size() - 1;
+    }
+    int node = free_nodes.back();
+    free_nodes.pop_back();
+    nodes[node] = tree_node;
+    return node;
+}
+
+void DominanceIndex::updateNode(int node)
+{
+    TreapNode& tree_node = nodes[node];
+    tree_node.min_key = tree_node.key;
+    tree_node.min_point = tree_node.position.second;
+    for (int child : {tree_node.left, tree_node.right})
+    {
+        if ((child >= 0) && (nodes[child].min_key < tree_node.min_key))
+        {
+            tree_node.min_key = nodes[child].min_key;
+            tree_node.min_point = nodes[child].min_point;
+        }
+    }
+}
+
+void DominanceIndex::split(int node, const std::pair<int, int>& position, int& left, int& right)
+{
+    if (node < 0)
+    {
+        left = -1;
+        right = -1;
+        return;
+    }
+    TreapNode& tree_node = nodes[node];
+    if (tree_node.position < position)
+    {
+        split(tree_node.right, position, tree_node.right, right);
+        left = node;
+    }
+    else
+    {
+        split(tree_node.left, position, left, tree_node.left);
+        right = node;
+    }
+    updateNode(node);
+}
+
+int DominanceIndex::merge(int left, int right)
+{
+    // All positions in left are before those in right
+    if ((left < 0) || (right < 0))
+    {
+        return (left < 0) ? right : left;
+    }
+    if (nodes[left].priority > nodes[right].priority)
+    {
+        int merged = merge(nodes[left].right, right);
+        nodes[left].right = merged;
+        updateNode(left);
+        return left;
+    }
+    int merged = merge(left, nodes[right].left);
+    nodes[right].left = merged;
+    updateNode(right);
+    return right;
+}
+
+void DominanceIndex::findMinIn(int node, int y_rank, Key& best_key, int& best_point, AlgoStats& stats) const
+{
+    auto consider = [&](const Key& key, int point) {
+        if ((best_point < 0) || (key < best_key))
+        {
+            best_key = key;
+            best_point = point;
+        }
+    };
+
+    while (node >= 0)
+    {
+        VP_COUNT(stats.index_nodes, 1);
+        const TreapNode& tree_node = nodes[node];
+        if (tree_node.position.first >= y_rank)
+        {
+            // The node and its right subtree are all high enough
+            consider(tree_node.key, tree_node.position.second);
+            if (tree_node.right >= 0)
+            {
+                consider(nodes[tree_node.right].min_key, nodes[tree_node.right].min_point);
+            }
+            node = tree_node.left;
+        }
+        else
+        {
+            node = tree_node.right;
+        }
+    }
+}
+
+
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+static void checkTwoDim(const std::string& algo_name, int dimensions)
+{
+    if (dimensions != 2)
+    {
+        std::string s = "Algo " + algo_name + " was instantiated with the two-dimensional engine for " + std::to_string(dimensions) + " dimensions";
+        throw std::runtime_error(s);
+    }
+}
+
+template<class Base, MEASURE M>
+int AlgoFitEngine2D<Base, M>::solveInstance(int hint_nb_bins)
+{
+    if (this->isSolved())
+    {
+        return this->getSolution(); // No need to solve twice
+    }
+    checkTwoDim(this->name, this->dimensions);
+
+    bool packed = true;
+    {
+        ScopedPhaseTimer phase_timer(this->timings, "solveInstance");
+        if (hint_nb_bins > 0)
+        {
+            this->bins.reserve(hint_nb_bins); // Small memory optimisation
+        }
+
+        if (this->is_FFD_type)
+        {
+            // Compute item measures and renumber items in decreasing size
+            this->initItemOrder();
+        }
+
+        // The bins are created at the end of the list while packing, and ordered afterwards
+        bool created_at_end = this->create_bins_at_end;
+        this->create_bins_at_end = true;
+        packed = packDominance(created_at_end);
+        this->create_bins_at_end = created_at_end;
+    }
+
+    if (!packed)
+    {
+        // Start again with the list of bins of the general engine
+        this->clearSolution();
+        return General::solveInstance(hint_nb_bins);
+    }
+
+    this->solved = true;
+    return this->getSolution();
+}
+
+template<class Base, MEASURE M>
+bool AlgoFitEngine2D<Base, M>::packDominance(bool created_at_end)
+{
+    BinList& bins = this->bins;
+    for (float weight : this->weights_list)
+    {
+        if (!std::isfinite(weight))
+        {
+            return false; // The measures may not be comparable
+        }
+    }
+
+    // The sizes of the items are the only thresholds of the queries
+    SizeList x_sizes;
+    SizeList y_sizes;
+    x_sizes.reserve(this->items.size());
+    y_sizes.reserve(this->items.size());
+    for (Item* item : this->items)
+    {
+        x_sizes.push_back(item->getSizes()[0]);
+        y_sizes.push_back(item->getSizes()[1]);
+    }
+    DominanceIndex index(x_sizes, y_sizes, this->items.size()); // At most one bin per item
+
+    // Keys in the order of the list of the general engine: a bin whose measure changes goes after
+    // the bins of the same measure if it moved towards the front of the list, and before them
+    // if it moved towards the back. A new bin goes after them if created at the end of the list
+    std::vector<DominanceIndex::Key> bin_keys; // Indexed by bin id
+    int step = 0;
+    for (Item* item : this->items)
+    {
+        this->checkCancelled();
+        ++step;
+        const SizeList& sizes = item->getSizes();
+
+        int bin_id = this->countIndexQuery(index.findMin(sizes[0], sizes[1], this->stats));
+        Bin* bin = nullptr;
+        if (bin_id < 0)
+        {
+            bin = Base::createNewBin();
+            this->packItem(item, bin);
+            bin_keys.push_back(makeKey(bin, (created_at_end ? step : -step)));
+        }
+        else
+        {
+            bin = bins[bin_id];
+            index.erase(bin_id);
+            DominanceIndex::Key& key = bin_keys[bin_id];
+            this->packItem(item, bin);
+            DominanceIndex::Key new_key = makeKey(bin, key.second);
+            if (new_key.first != key.first)
+            {
+                new_key.second = (new_key.first < key.first) ? step : -step;
+            }
+            key = new_key;
+        }
+        index.insert(bin->getId(), bin->getAvailableCapDim(0), bin->getAvailableCapDim(1), bin_keys[bin->getId()]);
+    }
+
+    // Same list of bins as the general engine, the bin measures were set when packing
+    std::vector<std::pair<DominanceIndex::Key, Bin*>> ordered_bins;
+    ordered_bins.reserve(bins.size());
+    for (Bin* bin : bins)
+    {
+        ordered_bins.emplace_back(bin_keys[bin->getId()], bin);
+    }
+    std::sort(ordered_bins.begin(), ordered_bins.end(),
+              [](const std::pair<DominanceIndex::Key, Bin*>& a, const std::pair<DominanceIndex::Key, Bin*>& b) {
+                  return a.first < b.first;
+              });
+    bins.clear();
+    for (const auto& entry : ordered_bins)
+    {
+        bins.push_back(entry.second);
+    }
+    return true;
+}
+
+template<class Base, MEASURE M>
+DominanceIndex::Key AlgoFitEngine2D<Base, M>::makeKey(Bin* bin, int tie) const
+{
+    // Same measure as the general engine, the first bins of the list have the lowest keys
+    float measure = bin->getMeasure();
+    return DominanceIndex::Key((General::IS_WORST ? -measure : measure), tie);
+}
+
+// All combinations created by the algorithm registry
+template class AlgoFitEngine2D<AlgoWFD_T1, MEASURE::LINF>;
+template class AlgoFitEngine2D<AlgoWFD_T1, MEASURE::L1>;
+template class AlgoFitEngine2D<AlgoWFD_T1, MEASURE::L2>;
+template class AlgoFitEngine2D<AlgoWFD_T1, MEASURE::L2_LOAD>;
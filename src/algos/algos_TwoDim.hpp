@@ -0,0 +1,98 @@
+#ifndef ALGOS_TWODIM_HPP
+#define ALGOS_TWODIM_HPP
+
+#include "algos_ItemCentric.hpp"
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace vectorpack;
+
+// Engines of the item-centric algorithms for two-dimensional instances
+// Finding the first bin of the list where an item fits is a 2-D dominance query over the
+// residual capacities of the bins, answered in O(log^2 m) instead of scanning the list
+
+
+// Points (x, y) with a key, for the queries: lowest key among the points with x >= a and y >= b
+// The coordinates are only compared with the values of a and b, given at construction as
+// thresholds, and are replaced by their rank among them (number of thresholds not above)
+// Range tree: segment tree over the ranks of x, where each node keeps its points in a treap
+// ordered by rank of y, with the lowest key of each subtree
+class DominanceIndex
+{
+public:
+    using Key = std::pair<float, int>; // Lower is better
+
+    DominanceIndex(const SizeList& x_thresholds, const SizeList& y_thresholds, int max_points);
+
+    void insert(int point, int x, int y, const Key& key); // Points are ids in [0, max_points)
+    void erase(int point);
+    // Point of lowest key with x >= a and y >= b (a and b among the thresholds), -1 if none
+    // The nodes visited in the treaps are counted in stats.index_nodes
+    int findMin(int a, int b, AlgoStats& stats) const;
+
+protected:
+    struct TreapNode
+    {
+        std::pair<int, int> position; // Rank of y, then point
+        Key key;
+        Key min_key;   // Lowest key of the subtree
+        int min_point; // Point of min_key
+        unsigned priority;
+        int left;
+        int right;
+    };
+
+    static int rankOf(const SizeList& thresholds, int value);
+
+    int newNode(int point, int y_rank, const Key& key);
+    void updateNode(int node);
+    void split(int node, const std::pair<int, int>& position, int& left, int& right); // left < position <= right
+    int merge(int left, int right);
+    void findMinIn(int node, int y_rank, Key& best_key, int& best_point, AlgoStats& stats) const;
+
+    SizeList x_thresholds; // Sorted, without duplicates
+    SizeList y_thresholds;
+    int nb_leaves; // Power of 2 above the number of ranks of x
+    std::vector<int> roots; // Treap of each node of the segment tree, with root 1, -1 if empty
+    std::vector<TreapNode> nodes;
+    std::vector<int> free_nodes;
+    std::vector<int> point_x_ranks; // -1 if the point is not in the index
+    std::vector<int> point_y_ranks;
+    unsigned random_state; // For the priorities of the treaps
+};
+
+
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+// Engine of WFD-T1 with static item weights
+// The bin measures are static, so that the general engine keeps its list sorted by bubbling the
+// bin which changed: the ties are in an order which only depends on when the bins last changed
+// measure. The bins are kept in a DominanceIndex with their position in that list as key,
+// and the first bin of the list where an item fits is the lowest key dominating its sizes
+// Instantiated in algos_TwoDim.cpp for each measure
+template<class Base, MEASURE M>
+class AlgoFitEngine2D final : public AlgoFitEngine<Base, M, false>
+{
+public:
+    using AlgoFitEngine<Base, M, false>::AlgoFitEngine;
+
+    virtual int solveInstance(int hint_nb_bins = 0);
+
+protected:
+    using General = AlgoFitEngine<Base, M, false>;
+
+    bool packDominance(bool created_at_end); // False if the measures cannot be ordered
+    DominanceIndex::Key makeKey(Bin* bin, int tie) const;
+};
+
+// BFD-T1 is not exactly Best Fit (see hasOneDimEngine), and keeps the general engine
+template<class Base>
+constexpr bool hasTwoDimEngine()
+{
+    return std::is_same<Base, AlgoWFD_T1>::value;
+}
+
+#endif // ALGOS_TWODIM_HPP
@@ -0,0 +1,100 @@
+#include "async_solver.hpp"
+#include "algo_utils.hpp"
+
+void SolveJob::cancel()
+{
+    token.cancel();
+}
+
+
+AsyncSolver::AsyncSolver(int nb_threads, int max_queued):
+    pool(nb_threads, max_queued)
+{ }
+
+AsyncSolver::~AsyncSolver()
+{ }
+
+SolveJob AsyncSolver::submit(std::shared_ptr<const Instance> instance, const std::string& algo_name,
+                             const SolveOptions& options)
+{
+    SolveJob job;
+    CancelToken token = job.token;
+    // The name is copied, as the algorithm keeps a reference to it
+    job.result = pool.submit([instance, algo_name, options, token]() {
+        return runJob(*instance, algo_name, options, token);
+    });
+    return job;
+}
+
+bool AsyncSolver::trySubmit(std::shared_ptr<const Instance> instance, const std::string& algo_name,
+                            const SolveOptions& options, SolveJob& job)
+{
+    SolveJob new_job;
+    CancelToken token = new_job.token;
+    auto task = [instance, algo_name, options, token]() {
+        return runJob(*instance, algo_name, options, token);
+    };
+    if (!pool.trySubmit(task, new_job.result))
+    {
+        return false;
+    }
+    job = std::move(new_job);
+    return true;
+}
+
+void AsyncSolver::wait()
+{
+    pool.wait();
+}
+
+void AsyncSolver::checkCancelled(const Instance& instance, const std::string& algo_name, const CancelToken& token)
+{
+    if (token.isCancelled())
+    {
+        std::string s = "Solve of algo " + algo_name + " on instance " + instance.getName() + " was cancelled";
+        throw SolveCancelled(s);
+    }
+}
+
+SolveResult AsyncSolver::runJob(const Instance& instance, const std::string& algo_name,
+                                const SolveOptions& options, const CancelToken& token)
+{
+    SolveResult result;
+    result.algo_name = algo_name;
+    result.LB = options.LB;
+    result.UB = -1;
+    result.solution = -1;
+    result.converged = true;
+    result.solve_time_ms = 0.0;
+
+    // The job may have been cancelled while it was waiting in the queue
+    checkCancelled(instance, algo_name, token);
+
+    if (result.LB < 0)
+    {
+        result.LB = LB_BPP(instance);
+    }
+    if (isMultiBinAlgo(algo_name))
+    {
+        // First Fit checks the token as well, it can take as long as the search on large instances
+        result.UB = (options.UB < 0) ? computeUpperBoundFF(instance, result.LB, token) : options.UB;
+    }
+    checkCancelled(instance, algo_name, token);
+
+    std::unique_ptr<BaseAlgo> algo(createAlgo(algo_name, instance));
+    algo->setCancelToken(token);
+    algo->setTimeLimit(options.time_limit_ms);
+    result.solution = solveWithAlgo(algo.get(), algo_name, result.LB, result.UB);
+    result.converged = algo->isConverged();
+    result.solve_time_ms = algo->getSolveTime();
+
+    if (algo->isSolved())
+    {
+        result.allocations.reserve(algo->getBins().size());
+        for (const Bin* bin : algo->getBins())
+        {
+            result.allocations.push_back(bin->getAllocList());
+        }
+    }
+    return result;
+}
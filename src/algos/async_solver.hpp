@@ -0,0 +1,75 @@
+#ifndef ASYNC_SOLVER_HPP
+#define ASYNC_SOLVER_HPP
+
+#include "base_algo.hpp"
+#include "cancel_token.hpp"
+#include "thread_pool.hpp"
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace vectorpack;
+
+// Options of one asynchronous solve
+struct SolveOptions
+{
+    int LB = -1;              // Computed with LB_BPP if negative
+    int UB = -1;              // For multi-bin algorithms, computed with First Fit if negative
+    double time_limit_ms = 0; // Time limit of multi-bin searches, 0 for no limit
+};
+
+// Result of one asynchronous solve
+struct SolveResult
+{
+    std::string algo_name;
+    int LB;
+    int UB;                // -1 for centric algorithms
+    int solution;          // Number of bins, -1 if no solution was found
+    bool converged;        // False if the time limit was reached
+    double solve_time_ms;
+    std::vector<AllocList> allocations; // Item ids of each bin of the solution
+};
+
+// Handle of a submitted solve
+// The future throws SolveCancelled if the job was cancelled,
+// or any error of the algorithm (e.g. unknown algorithm name)
+struct SolveJob
+{
+    std::future<SolveResult> result;
+    CancelToken token;
+
+    void cancel(); // Cancels the job, whether it is still queued or running
+};
+
+// Job-based API to solve instances in the background
+// Jobs run on an internal pool of threads, with at most max_queued jobs waiting
+// to be started: submit blocks and trySubmit fails while the queue is full
+class AsyncSolver
+{
+public:
+    AsyncSolver(int nb_threads = 0, int max_queued = 0); // 0 threads for all hardware threads, 0 queued for no bound
+    virtual ~AsyncSolver(); // Waits for all jobs to complete, cancel them first to stop early
+
+    AsyncSolver(const AsyncSolver&) = delete;
+    AsyncSolver& operator=(const AsyncSolver&) = delete;
+
+    // The instance is shared with the job, and must not be modified until the job completes
+    SolveJob submit(std::shared_ptr<const Instance> instance, const std::string& algo_name,
+                    const SolveOptions& options = SolveOptions());
+    bool trySubmit(std::shared_ptr<const Instance> instance, const std::string& algo_name,
+                   const SolveOptions& options, SolveJob& job); // False if the queue is full
+
+    void wait(); // Block until all submitted jobs are completed
+
+protected:
+    static SolveResult runJob(const Instance& instance, const std::string& algo_name,
+                              const SolveOptions& options, const CancelToken& token);
+    // Throws SolveCancelled if the job was cancelled, between the phases of runJob
+    static void checkCancelled(const Instance& instance, const std::string& algo_name, const CancelToken& token);
+
+    ThreadPool pool;
+};
+
+#endif // ASYNC_SOLVER_HPP
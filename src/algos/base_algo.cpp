@@ -6,13 +6,19 @@
 BaseAlgo::BaseAlgo(const std::string& algo_name, const Instance &instance):
     name(algo_name),
     items(ItemList(instance.getItems())),
+    item_measures(FloatList(instance.getNbItems(), 0.0)),
     bins(BinList(0)),
     bin_max_capacities(instance.getBinCapacities()),
     instance(instance),
     dimensions(instance.getDimensions()),
     next_bin_index(0),
     solved(false),
-    create_bins_at_end(true)
+    create_bins_at_end(true),
+    time_limit_ms(0.0),
+    has_deadline(false),
+    deadline_expired(false),
+    converged(true),
+    deadline_checks(0)
 { }
 
 BaseAlgo::~BaseAlgo()
@@ -22,6 +28,11 @@ BaseAlgo::~BaseAlgo()
         if (bin != nullptr)
             delete bin;
     }
+    for (Bin* bin : recycled_bins)
+    {
+        if (bin != nullptr)
+            delete bin;
+    }
 }
 
 bool BaseAlgo::isSolved() const
@@ -55,6 +66,42 @@ const ItemList& BaseAlgo::getItems() const
     return items;
 }
 
+const PhaseTimer& BaseAlgo::getTimings() const
+{
+    return timings;
+}
+
+const AlgoStats& BaseAlgo::getStats() const
+{
+    return stats;
+}
+
+void BaseAlgo::setTimeLimit(double time_limit_ms)
+{
+    this->time_limit_ms = time_limit_ms;
+}
+
+bool BaseAlgo::isConverged() const
+{
+    return converged;
+}
+
+void BaseAlgo::setCancelToken(const CancelToken& token)
+{
+    cancel_token = token;
+}
+
+void BaseAlgo::throwCancelled() const
+{
+    std::string s = "Solve of algo " + name + " on instance " + instance.getName() + " was cancelled";
+    throw SolveCancelled(s);
+}
+
+double BaseAlgo::getSolveTime() const
+{
+    return timings.getPhaseTime("solveInstance") + timings.getPhaseTime("solveInstanceMultiBin");
+}
+
 void BaseAlgo::orderBinsId()
 {
     std::stable_sort(bins.begin(), bins.end(), bin_comparator_measure_increasing);
@@ -117,11 +164,55 @@ void BaseAlgo::clearSolution()
     }
     bins.clear();
     next_bin_index = 0;
+
+    for (Bin* bin : recycled_bins)
+    {
+        if (bin != nullptr)
+        {
+            delete bin;
+        }
+    }
+    recycled_bins.clear();
+}
+
+void BaseAlgo::recycleSolution()
+{
+    solved = false;
+
+    // Bins are put aside at the position of their id
+    // so that createNewBin gives back the same ids as with fresh bins
+    for (Bin* bin : bins)
+    {
+        int id = bin->getId();
+        if (id >= (int)recycled_bins.size())
+        {
+            recycled_bins.resize(id + 1, nullptr);
+        }
+        if (recycled_bins[id] != nullptr)
+        {
+            delete recycled_bins[id]; // Should not happen, ids are unique in a solution
+        }
+        recycled_bins[id] = bin;
+    }
+    bins.clear(); // Capacity of the vector is kept
+    next_bin_index = 0;
 }
 
 Bin* BaseAlgo::createNewBin()
 {
-    Bin* bin = new Bin(next_bin_index, bin_max_capacities);
+    Bin* bin = nullptr;
+    if ((next_bin_index < (int)recycled_bins.size()) && (recycled_bins[next_bin_index] != nullptr))
+    {
+        // Re-use a previously allocated bin
+        bin = recycled_bins[next_bin_index];
+        recycled_bins[next_bin_index] = nullptr;
+        bin->reset();
+    }
+    else
+    {
+        bin = new Bin(next_bin_index, bin_max_capacities);
+    }
+
     if (create_bins_at_end)
     {
         bins.push_back(bin);
@@ -132,16 +223,67 @@ Bin* BaseAlgo::createNewBin()
         bins.insert(bins.begin(), bin);
     }
     next_bin_index += 1;
+    VP_COUNT(stats.bins_created, 1);
 
     return bin;
 }
 
+void BaseAlgo::startDeadline()
+{
+    has_deadline = (time_limit_ms > 0.0);
+    deadline_expired = false;
+    converged = true;
+    deadline_checks = 0;
+    if (has_deadline)
+    {
+        deadline = std::chrono::steady_clock::now()
+                 + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(time_limit_ms));
+    }
+}
+
+bool BaseAlgo::isDeadlineExpired()
+{
+    if (has_deadline && !deadline_expired)
+    {
+        deadline_expired = (std::chrono::steady_clock::now() >= deadline);
+    }
+    return deadline_expired;
+}
+
+int BaseAlgo::solveFallbackFF()
+{
+    // Same solution as the First Fit upper bound
+    clearSolution();
+    for (Item* item : instance.getItems())
+    {
+        Bin* target_bin = nullptr;
+        for (Bin* bin : bins)
+        {
+            if (bin->doesItemFit(item->getSizes()))
+            {
+                target_bin = bin;
+                break;
+            }
+        }
+        if (target_bin == nullptr)
+        {
+            target_bin = BaseAlgo::createNewBin(); // Without the bookkeeping of the derived algorithms
+        }
+        target_bin->addItem(item);
+    }
+
+    solved = true;
+    converged = false;
+    return getSolution();
+}
+
 bool BaseAlgo::checkItemToBin(Item* item, Bin* bin) const
 {
-    return (bin->doesItemFit(item->getSizes()));
+    return countFitCheck(bin->doesItemFit(item->getSizes()));
 }
 
 void BaseAlgo::addItemToBin(Item* item, Bin* bin)
 {
     bin->addItem(item);
+    VP_COUNT(stats.items_packed, 1);
 }
@@ -4,6 +4,11 @@
 #include "item.hpp"
 #include "instance.hpp"
 #include "bin.hpp"
+#include "timing.hpp"
+#include "algo_stats.hpp"
+#include "cancel_token.hpp"
+
+#include <chrono>
 
 using namespace vectorpack;
 
@@ -27,25 +32,102 @@ public:
 
     void setSolution(BinList& bins);
     void clearSolution();
+    void recycleSolution(); // Like clearSolution, but bins are kept aside to be re-used by createNewBin
 
     virtual int solveInstance(int hint_nb_bins = 0) = 0; // For Centric algorithms ONLY
     virtual int solveInstanceMultiBin(int LB, int UB) = 0; // For Multi-bin algorithms ONLY
 
+    // Time spent in the solve methods of the algorithm (and in each probe of multi-bin algorithms)
+    const PhaseTimer& getTimings() const;
+    double getSolveTime() const; // In milliseconds
+
+    // Operation counters, only updated when built with VECTORPACK_COUNTERS
+    const AlgoStats& getStats() const;
+
+    // Wall-clock budget of the multi-bin searches, counted from the start of solveInstanceMultiBin
+    // When it expires, the best solution found so far is returned (or a First Fit solution)
+    void setTimeLimit(double time_limit_ms); // 0 or less for no limit (default)
+    bool isConverged() const; // False if the last solve was stopped by the time limit
+
+    // The solve methods throw SolveCancelled soon after the token is cancelled
+    void setCancelToken(const CancelToken& token);
+
 protected:
     virtual Bin* createNewBin(); // Open a new empty bin
     virtual bool checkItemToBin(Item* item, Bin* bin) const;
     virtual void addItemToBin(Item* item, Bin* bin);
 
+    // Combined size measures of items, owned by the algorithm so that the instance is never modified
+    float getItemMeasure(const Item* item) const { return item_measures[item->getId()]; }
+    void setItemMeasure(const Item* item, float measure) { item_measures[item->getId()] = measure; }
+
+    // Helpers to update the operation counters, no-ops unless VECTORPACK_COUNTERS is defined
+    bool countFitCheck(bool fits) const // Returns fits
+    {
+        VP_COUNT(stats.fit_checks, 1);
+        VP_COUNT(stats.fit_failures, (fits ? 0 : 1));
+        return fits;
+    }
+    int countIndexQuery(int bin_index) const // Returns bin_index, -1 if the index found no bin
+    {
+        // The bin found in an index of the bins is the only one checked
+        VP_COUNT(stats.bins_scanned, ((bin_index >= 0) ? 1 : 0));
+        countFitCheck(bin_index >= 0);
+        return bin_index;
+    }
+    void countSort(long nb_elements) const
+    {
+        VP_COUNT(stats.sort_calls, 1);
+        VP_COUNT(stats.sort_elements, nb_elements);
+    }
+    void countBubble(int nb_swaps) const
+    {
+        VP_COUNT(stats.bubble_calls, 1);
+        VP_COUNT(stats.bubble_swaps, nb_swaps);
+    }
+
+    void startDeadline(); // Start counting the time limit, if any
+    // Cheap check for the inner loops, the clock is only read once every DEADLINE_CHECK_PERIOD calls
+    bool checkDeadline()
+    {
+        return has_deadline && (deadline_expired || ((++deadline_checks % DEADLINE_CHECK_PERIOD == 0) && isDeadlineExpired()));
+    }
+    bool isDeadlineExpired(); // Always reads the clock
+    int solveFallbackFF(); // First Fit solution in the order of the instance, when the time limit expired
+
+    void checkCancelled() const // Throws SolveCancelled if the solve was cancelled
+    {
+        if (cancel_token.isCancelled())
+        {
+            throwCancelled();
+        }
+    }
+    [[noreturn]] void throwCancelled() const;
+
 protected:
     const std::string& name;
     int next_bin_index;
     ItemList items;
+    FloatList item_measures; // Placeholder for a combined size measure of each item, indexed by item id
     BinList bins;
+    BinList recycled_bins; // Emptied bins available for re-use, indexed by bin id
     const SizeList& bin_max_capacities;
     const Instance& instance;
     const int dimensions;
     bool create_bins_at_end; // Whether a newly created bin should be put at the end of the list or not
     bool solved;
+    PhaseTimer timings;
+    mutable AlgoStats stats; // Also updated by const fit checks
+
+    static const int DEADLINE_CHECK_PERIOD = 16;
+    double time_limit_ms;
+    bool has_deadline;
+    bool deadline_expired;
+    bool converged;
+    int deadline_checks;
+    std::chrono::steady_clock::time_point deadline;
+
+    CancelToken cancel_token; // Never cancelled unless set by the caller
 };
 
 #endif // BASE_ALGO_HPP
@@ -0,0 +1,246 @@
+#include "batch.hpp"
+#include "algo_utils.hpp"
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std::chrono;
+
+std::vector<BatchJob> readBatchManifest(const std::string& filename)
+{
+    std::ifstream ifile(filename.c_str());
+    if (!ifile.is_open())
+    {
+        std::string s = "Could not open batch manifest " + filename;
+        throw std::runtime_error(s);
+    }
+
+    std::vector<BatchJob> jobs;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(ifile, line))
+    {
+        line_number++;
+        for (char& c : line)
+        {
+            if ((c == ',') || (c == '\t') || (c == '\r'))
+            {
+                c = ' ';
+            }
+        }
+
+        std::istringstream line_stream(line);
+        BatchJob job;
+        if (!(line_stream >> job.instance_file) || (job.instance_file[0] == '#'))
+        {
+            continue; // Empty or comment line
+        }
+
+        std::string algo_name;
+        while (line_stream >> algo_name)
+        {
+            job.algo_names.push_back(algo_name);
+        }
+        if (job.algo_names.empty())
+        {
+            std::string s = "No algorithm given for instance " + job.instance_file + " at line " + std::to_string(line_number) + " of " + filename;
+            throw std::runtime_error(s);
+        }
+        job.algo_names = expandAlgoNames(job.algo_names); // "all" and "<prefix>*" selections
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+
+// Escape a string value for the CSV format
+static std::string csvField(const std::string& str)
+{
+    if (str.find_first_of(",\"\n") == std::string::npos)
+    {
+        return str;
+    }
+    std::string s = "\"";
+    for (char c : str)
+    {
+        if (c == '"')
+        {
+            s += '"';
+        }
+        s += c;
+    }
+    return s + "\"";
+}
+
+// Escape a string value for the JSON format
+static std::string jsonString(const std::string& str)
+{
+    std::string s = "\"";
+    for (char c : str)
+    {
+        switch (c)
+        {
+        case '"': s += "\\\""; break;
+        case '\\': s += "\\\\"; break;
+        case '\n': s += "\\n"; break;
+        case '\t': s += "\\t"; break;
+        default: s += c;
+        }
+    }
+    return s + "\"";
+}
+
+static double elapsedMs(const steady_clock::time_point& start)
+{
+    return duration<double, std::milli>(steady_clock::now() - start).count();
+}
+
+
+BatchRunner::BatchRunner(const std::vector<BatchJob>& jobs, std::ostream& output,
+                         const BATCH_FORMAT format, const bool shuffle_items,
+                         const std::string& lb_name, const double time_limit_ms):
+    jobs(jobs),
+    output(output),
+    format(format),
+    shuffle_items(shuffle_items),
+    lb_name(lb_name),
+    time_limit_ms(time_limit_ms),
+    nb_failed(0)
+{ }
+
+int BatchRunner::run(int nb_threads)
+{
+    nb_failed = 0;
+    writeHeader();
+
+    ThreadPool pool(nb_threads);
+    for (const BatchJob& job : jobs)
+    {
+        // First load the instance, then each algorithm is a new task
+        // pushed in the queue of the worker which loaded the instance
+        pool.submit([this, &job, &pool]() {
+            std::string instance_name = job.instance_file.substr(job.instance_file.find_last_of("/\\") + 1);
+            BatchRecord base_record = {instance_name, "", 0, 0, -1, -1, 0.0, 0.0, 0.0, ""};
+
+            std::shared_ptr<Instance> instance;
+            int UB = -1;
+            try {
+                steady_clock::time_point start = steady_clock::now();
+                instance = std::make_shared<Instance>(instance_name, job.instance_file, shuffle_items);
+                base_record.load_time_ms = elapsedMs(start);
+                base_record.nb_items = instance->getNbItems();
+                base_record.dimensions = instance->getDimensions();
+
+                start = steady_clock::now();
+                base_record.LB = computeLowerBound(lb_name, *instance);
+                base_record.LB_time_ms = elapsedMs(start);
+
+                for (const std::string& algo_name : job.algo_names)
+                {
+                    if (isMultiBinAlgo(algo_name))
+                    {
+                        UB = computeUpperBoundFF(*instance, base_record.LB);
+                        break;
+                    }
+                }
+            }
+            catch (std::exception& e)
+            {
+                // All algorithms of this instance fail
+                base_record.error = e.what();
+                for (const std::string& algo_name : job.algo_names)
+                {
+                    BatchRecord record = base_record;
+                    record.algo_name = algo_name;
+                    writeRecord(record);
+                }
+                return;
+            }
+
+            for (const std::string& algo_name : job.algo_names)
+            {
+                pool.submit([this, instance, base_record, &algo_name, UB]() {
+                    BatchRecord record = base_record;
+                    record.algo_name = algo_name;
+
+                    BaseAlgo* algo = nullptr;
+                    try {
+                        steady_clock::time_point start = steady_clock::now();
+                        algo = createAlgo(algo_name, *instance);
+                        algo->setTimeLimit(time_limit_ms);
+                        record.solution = solveWithAlgo(algo, algo_name, record.LB, UB);
+                        record.solve_time_ms = elapsedMs(start);
+                    }
+                    catch (std::exception& e)
+                    {
+                        record.error = e.what();
+                    }
+                    if (algo != nullptr)
+                    {
+                        delete algo;
+                    }
+                    writeRecord(record);
+                });
+            }
+        });
+    }
+    pool.wait();
+
+    return nb_failed;
+}
+
+void BatchRunner::writeHeader()
+{
+    if (format == BATCH_FORMAT::CSV)
+    {
+        output << "instance,algorithm,nb_items,dimensions,LB,bins,load_time_ms,LB_time_ms,solve_time_ms,error\n";
+        output.flush();
+    }
+}
+
+void BatchRunner::writeRecord(const BatchRecord& record)
+{
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    if (format == BATCH_FORMAT::CSV)
+    {
+        ss << csvField(record.instance_name) << ","
+           << csvField(record.algo_name) << ","
+           << record.nb_items << ","
+           << record.dimensions << ","
+           << record.LB << ","
+           << record.solution << ","
+           << record.load_time_ms << ","
+           << record.LB_time_ms << ","
+           << record.solve_time_ms << ","
+           << csvField(record.error) << "\n";
+    }
+    else
+    {
+        ss << "{\"instance\": " << jsonString(record.instance_name)
+           << ", \"algorithm\": " << jsonString(record.algo_name)
+           << ", \"nb_items\": " << record.nb_items
+           << ", \"dimensions\": " << record.dimensions
+           << ", \"LB\": " << record.LB
+           << ", \"bins\": " << record.solution
+           << ", \"load_time_ms\": " << record.load_time_ms
+           << ", \"LB_time_ms\": " << record.LB_time_ms
+           << ", \"solve_time_ms\": " << record.solve_time_ms
+           << ", \"error\": " << jsonString(record.error) << "}\n";
+    }
+
+    // Records are streamed in completion order, one full line at a time
+    std::lock_guard<std::mutex> lock(output_mutex);
+    if (!record.error.empty())
+    {
+        nb_failed += 1;
+    }
+    output << ss.str();
+    output.flush();
+}
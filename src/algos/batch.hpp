@@ -0,0 +1,78 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// One line of a batch manifest: an instance file and the algorithms to run on it
+struct BatchJob
+{
+    std::string instance_file;
+    std::vector<std::string> algo_names;
+};
+
+// Format of the results of a batch
+enum class BATCH_FORMAT {
+     CSV
+    ,JSONL // One JSON object per line
+};
+
+const static std::map<std::string, BATCH_FORMAT> map_str_to_batch_format = {
+    { "csv", BATCH_FORMAT::CSV },
+    { "jsonl", BATCH_FORMAT::JSONL },
+};
+
+// Read a batch manifest
+// Each non-empty line which does not start with '#' contains an instance file
+// followed by one or more algorithm names, separated by spaces or commas
+// "all" and names ending with '*' select several algorithms, see expandAlgoNames
+std::vector<BatchJob> readBatchManifest(const std::string& filename);
+
+// Run all (instance, algorithm) pairs of a manifest on a work-stealing pool of threads
+// Each instance is loaded once and shared by its algorithms
+// Results are written to the output stream as soon as each algorithm completes
+class BatchRunner
+{
+public:
+    BatchRunner(const std::vector<BatchJob>& jobs, std::ostream& output,
+                const BATCH_FORMAT format = BATCH_FORMAT::CSV,
+                const bool shuffle_items = true,
+                const std::string& lb_name = "LB_BPP",
+                const double time_limit_ms = 0.0); // Of each multi-bin algorithm, see BaseAlgo::setTimeLimit
+
+    // Returns the number of (instance, algorithm) pairs that failed
+    int run(int nb_threads = 0);
+
+protected:
+    struct BatchRecord
+    {
+        std::string instance_name;
+        std::string algo_name;
+        int nb_items;
+        int dimensions;
+        int LB;
+        int solution;
+        double load_time_ms;
+        double LB_time_ms;
+        double solve_time_ms;
+        std::string error;
+    };
+
+    void writeHeader();
+    void writeRecord(const BatchRecord& record);
+
+    const std::vector<BatchJob>& jobs;
+    std::ostream& output;
+    const BATCH_FORMAT format;
+    const bool shuffle_items;
+    const std::string lb_name; // Lower bound of the instances, see computeLowerBound
+    const double time_limit_ms;
+
+    std::mutex output_mutex;
+    int nb_failed;
+};
+
+#endif // BATCH_HPP
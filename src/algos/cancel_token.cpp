@@ -0,0 +1,21 @@
+#include "cancel_token.hpp"
+
+SolveCancelled::SolveCancelled(const std::string& what):
+    std::runtime_error(what)
+{ }
+
+
+CancelToken::CancelToken():
+    cancelled(std::make_shared<std::atomic<bool>>(false))
+{ }
+
+void CancelToken::cancel()
+{
+    cancelled->store(true, std::memory_order_relaxed);
+}
+
+bool CancelToken::isCancelled() const
+{
+    // Relaxed is enough, the flag does not guard any other data
+    return cancelled->load(std::memory_order_relaxed);
+}
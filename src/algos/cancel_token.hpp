@@ -0,0 +1,30 @@
+#ifndef CANCEL_TOKEN_HPP
+#define CANCEL_TOKEN_HPP
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// Thrown by an algorithm when its solve is cancelled
+class SolveCancelled : public std::runtime_error
+{
+public:
+    SolveCancelled(const std::string& what);
+};
+
+// Shared flag to request the cancellation of a solve from another thread
+// Copies of a token share the same flag
+class CancelToken
+{
+public:
+    CancelToken();
+
+    void cancel();
+    bool isCancelled() const;
+
+protected:
+    std::shared_ptr<std::atomic<bool>> cancelled;
+};
+
+#endif // CANCEL_TOKEN_HPP
@@ -0,0 +1,280 @@
+#include "concurrent_online_packer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// The residual capacities are independent counters: relaxed atomic operations are enough
+// to never overcommit a dimension, as each update is a single atomic operation
+// The block bounds and versions use sequentially consistent operations, so that a search
+// which reads a version after a release also reads the residual capacities it gave back
+static const std::memory_order relaxed = std::memory_order_relaxed;
+
+template<typename T>
+static void atomicMax(std::atomic<T>& target, T value)
+{
+    T current = target.load();
+    while ((current < value) && !target.compare_exchange_weak(current, value))
+    { }
+}
+
+ConcurrentOnlinePacker::ConcurrentOnlinePacker(const SizeList& capacities, int max_bins):
+    capacities(capacities),
+    dimensions(capacities.size()),
+    max_bins(max_bins),
+    residuals((size_t)std::max(max_bins, 0) * capacities.size()),
+    nb_bins(0),
+    block_residuals((size_t)((std::max(max_bins, 0) + BLOCK_SIZE - 1) / BLOCK_SIZE) * capacities.size()),
+    block_profiles(block_residuals.size()),
+    block_versions(block_residuals.size() / std::max((int)capacities.size(), 1))
+{
+    if ((dimensions <= 0) || (max_bins <= 0))
+    {
+        throw std::runtime_error("The concurrent online packer needs at least one dimension and one bin");
+    }
+    for (int bin_id = 0; bin_id < max_bins; ++bin_id)
+    {
+        for (int h = 0; h < dimensions; ++h)
+        {
+            residual(bin_id, h).store(capacities[h], relaxed);
+        }
+    }
+    // The bins are empty: the bounds are the capacities
+    for (size_t block = 0; block < block_versions.size(); ++block)
+    {
+        for (int h = 0; h < dimensions; ++h)
+        {
+            block_residuals[block * dimensions + h].store(capacities[h]);
+            block_profiles[block * dimensions + h].store(1.0f);
+        }
+        block_versions[block].store(0);
+    }
+}
+
+ConcurrentOnlinePacker::~ConcurrentOnlinePacker()
+{ }
+
+int ConcurrentOnlinePacker::place(const SizeList& sizes)
+{
+    if ((int)sizes.size() != dimensions)
+    {
+        std::string s = "Item with " + std::to_string(sizes.size()) + " dimensions instead of " + std::to_string(dimensions);
+        throw std::runtime_error(s);
+    }
+    for (int h = 0; h < dimensions; ++h)
+    {
+        if ((sizes[h] < 0) || (sizes[h] > capacities[h]))
+        {
+            throw std::runtime_error("Item does not fit in an empty bin");
+        }
+    }
+
+    FloatList item_profile(dimensions);
+    computeProfile(sizes, item_profile.data());
+    SizeList bin_values(dimensions);     // Buffers for the refresh of the bounds
+    FloatList bin_profile(dimensions);
+
+    while (true)
+    {
+        int opened = nb_bins.load();
+        for (int first = 0; first < opened; first += BLOCK_SIZE)
+        {
+            int block = first / BLOCK_SIZE;
+            if (!blockMayFit(block, sizes, item_profile))
+            {
+                continue;
+            }
+            int last = std::min(first + BLOCK_SIZE, opened);
+            for (int bin_id = first; bin_id < last; ++bin_id)
+            {
+                if (mayFit(bin_id, sizes) && tryReserve(bin_id, sizes))
+                {
+                    return bin_id;
+                }
+            }
+            refreshBlockBounds(block, bin_values, bin_profile);
+        }
+
+        if (opened == max_bins)
+        {
+            std::string s = "All " + std::to_string(max_bins) + " bins of the concurrent online packer are full";
+            throw std::runtime_error(s);
+        }
+
+        // Open the next bin, unless other threads opened it and filled it in the meantime
+        if (tryReserve(opened, sizes))
+        {
+            int expected = opened;
+            while ((expected <= opened) && !nb_bins.compare_exchange_weak(expected, opened + 1))
+            { }
+            return opened;
+        }
+    }
+}
+
+void ConcurrentOnlinePacker::release(int bin_id, const SizeList& sizes)
+{
+    if ((bin_id < 0) || (bin_id >= nb_bins.load()))
+    {
+        std::string s = "Bin " + std::to_string(bin_id) + " is not opened";
+        throw std::runtime_error(s);
+    }
+    giveBack(bin_id, sizes, dimensions);
+}
+
+void ConcurrentOnlinePacker::giveBack(int bin_id, const SizeList& sizes, int nb_dims)
+{
+    for (int h = 0; h < nb_dims; ++h)
+    {
+        residual(bin_id, h).fetch_add(sizes[h], relaxed);
+    }
+
+    int block = bin_id / BLOCK_SIZE;
+    block_versions[block].fetch_add(1);
+    SizeList values(dimensions);
+    FloatList profile(dimensions);
+    loadProfile(bin_id, values, profile.data());
+    raiseBlockBounds(block, values, profile.data());
+}
+
+void ConcurrentOnlinePacker::computeProfile(const SizeList& values, float* profile) const
+{
+    // Same computation as OnlinePacker::computeProfile, the comparisons stay exact
+    for (int h = 0; h < dimensions; ++h)
+    {
+        profile[h] = ((float)values[h]) / capacities[h];
+    }
+    std::sort(profile, profile + dimensions);
+}
+
+void ConcurrentOnlinePacker::loadProfile(int bin_id, SizeList& values, float* profile) const
+{
+    for (int h = 0; h < dimensions; ++h)
+    {
+        values[h] = residual(bin_id, h).load(relaxed);
+    }
+    computeProfile(values, profile);
+}
+
+bool ConcurrentOnlinePacker::blockMayFit(int block, const SizeList& sizes, const FloatList& profile) const
+{
+    const std::atomic<int>* block_residual = &block_residuals[(size_t)block * dimensions];
+    const std::atomic<float>* block_profile = &block_profiles[(size_t)block * dimensions];
+    for (int h = 0; h < dimensions; ++h)
+    {
+        if ((block_residual[h].load() < sizes[h]) || (block_profile[h].load() < profile[h]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ConcurrentOnlinePacker::raiseBlockBounds(int block, const SizeList& values, const float* profile)
+{
+    for (int h = 0; h < dimensions; ++h)
+    {
+        atomicMax(block_residuals[(size_t)block * dimensions + h], values[h]);
+        atomicMax(block_profiles[(size_t)block * dimensions + h], profile[h]);
+    }
+}
+
+void ConcurrentOnlinePacker::refreshBlockBounds(int block, SizeList& values, FloatList& profile)
+{
+    // The bins not opened yet are empty and are part of the block, which keeps the bounds valid
+    // when they are opened
+    int first = block * BLOCK_SIZE;
+    int last = std::min(first + BLOCK_SIZE, max_bins);
+    SizeList max_residuals(dimensions);
+    FloatList max_profile(dimensions);
+
+    unsigned version = block_versions[block].load();
+    while (true)
+    {
+        std::fill(max_residuals.begin(), max_residuals.end(), 0);
+        std::fill(max_profile.begin(), max_profile.end(), 0.0f);
+        for (int bin_id = first; bin_id < last; ++bin_id)
+        {
+            loadProfile(bin_id, values, profile.data());
+            for (int h = 0; h < dimensions; ++h)
+            {
+                max_residuals[h] = std::max(max_residuals[h], values[h]);
+                max_profile[h] = std::max(max_profile[h], profile[h]);
+            }
+        }
+        for (int h = 0; h < dimensions; ++h)
+        {
+            block_residuals[(size_t)block * dimensions + h].store(max_residuals[h]);
+            block_profiles[(size_t)block * dimensions + h].store(max_profile[h]);
+        }
+
+        // A release between the two reads of the version may have been missed by the loads
+        // and overwritten by the stores: compute the bounds again
+        unsigned current = block_versions[block].load();
+        if (current == version)
+        {
+            return;
+        }
+        version = current;
+    }
+}
+
+bool ConcurrentOnlinePacker::mayFit(int bin_id, const SizeList& sizes) const
+{
+    for (int h = 0; h < dimensions; ++h)
+    {
+        if (residual(bin_id, h).load(relaxed) < sizes[h])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ConcurrentOnlinePacker::tryReserve(int bin_id, const SizeList& sizes)
+{
+    for (int h = 0; h < dimensions; ++h)
+    {
+        std::atomic<int>& counter = residual(bin_id, h);
+        int available = counter.load(relaxed);
+        // On failure, available is reloaded with the current value and the test is done again
+        while ((available >= sizes[h]) && !counter.compare_exchange_weak(available, available - sizes[h], relaxed))
+        { }
+
+        if (available < sizes[h])
+        {
+            // Give back the dimensions already reserved, a bound computed in the meantime may have missed them
+            if (h > 0)
+            {
+                giveBack(bin_id, sizes, h);
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+int ConcurrentOnlinePacker::getNbBins() const
+{
+    return nb_bins.load();
+}
+
+int ConcurrentOnlinePacker::getMaxBins() const
+{
+    return max_bins;
+}
+
+SizeList ConcurrentOnlinePacker::getAvailableCaps(int bin_id) const
+{
+    SizeList available(dimensions);
+    for (int h = 0; h < dimensions; ++h)
+    {
+        available[h] = residual(bin_id, h).load(relaxed);
+    }
+    return available;
+}
+
+const SizeList& ConcurrentOnlinePacker::getCapacities() const
+{
+    return capacities;
+}
@@ -0,0 +1,85 @@
+#ifndef CONCURRENT_ONLINE_PACKER_HPP
+#define CONCURRENT_ONLINE_PACKER_HPP
+
+#include "item.hpp"
+
+#include <atomic>
+#include <vector>
+
+using namespace vectorpack;
+
+// Thread-safe First Fit packer for items arriving from several threads at the same time
+// The residual capacities of the bins are atomic counters, there is no global lock:
+// - a thread looks for the first bin where the item seems to fit (same test as Bin::doesItemFit)
+// - it reserves the capacity dimension by dimension with compare-and-swap,
+//   retrying when another thread changed the same counter in the meantime
+// - if a dimension is too small, the dimensions already reserved are given back
+//   and the search goes on with the next bin
+// A residual capacity never gets below 0, so no dimension is ever overcommitted
+// Under contention an item may skip a bin where it would fit, the placement is then
+// the one of First Fit in some order of the concurrent arrivals
+//
+// As in OnlinePacker, the bins are grouped in blocks of BLOCK_SIZE consecutive bins, and
+// the search skips the blocks whose bounds show that the item fits in none of their bins:
+// the maximum residual capacity in each dimension and the maximum of each order statistic
+// of the normalized residual capacities. The bounds are upper bounds, never exact:
+// - a reservation leaves them unchanged
+// - a release (or the rollback of a partial reservation) raises them with an atomic maximum
+// - a search which finds no room in a block recomputes them, and recomputes them again
+//   if a release happened in the block in the meantime (detected by a version counter)
+class ConcurrentOnlinePacker
+{
+public:
+    ConcurrentOnlinePacker(const SizeList& capacities, int max_bins);
+    virtual ~ConcurrentOnlinePacker();
+
+    ConcurrentOnlinePacker(const ConcurrentOnlinePacker&) = delete;
+    ConcurrentOnlinePacker& operator=(const ConcurrentOnlinePacker&) = delete;
+
+    // Reserve the sizes in a bin, opening a new bin if needed, and return the bin id
+    // Throws if the item does not fit in an empty bin or if all max_bins bins are full
+    int place(const SizeList& sizes);
+
+    // Give back the sizes of an item placed in the bin (bins are never closed)
+    void release(int bin_id, const SizeList& sizes);
+
+    int getNbBins() const; // Number of opened bins
+    int getMaxBins() const;
+    SizeList getAvailableCaps(int bin_id) const; // Snapshot, may be outdated when returned
+    const SizeList& getCapacities() const;
+
+protected:
+    static const int BLOCK_SIZE = 16; // Number of bins sharing the same bounds
+
+    std::atomic<int>& residual(int bin_id, int dim)
+    {
+        return residuals[(size_t)bin_id * dimensions + dim];
+    }
+    const std::atomic<int>& residual(int bin_id, int dim) const
+    {
+        return residuals[(size_t)bin_id * dimensions + dim];
+    }
+
+    void computeProfile(const SizeList& values, float* profile) const; // Sorted normalized values
+    void loadProfile(int bin_id, SizeList& values, float* profile) const; // From the current residuals
+
+    bool blockMayFit(int block, const SizeList& sizes, const FloatList& profile) const;
+    void raiseBlockBounds(int block, const SizeList& values, const float* profile);
+    void refreshBlockBounds(int block, SizeList& values, FloatList& profile);
+
+    bool mayFit(int bin_id, const SizeList& sizes) const; // Without reservation
+    bool tryReserve(int bin_id, const SizeList& sizes);   // Reserve all dimensions or none
+    void giveBack(int bin_id, const SizeList& sizes, int nb_dims); // The first nb_dims dimensions
+
+    const SizeList capacities;
+    const int dimensions;
+    const int max_bins;
+    std::vector<std::atomic<int>> residuals; // Residual capacities, bin_id * dimensions + h
+    std::atomic<int> nb_bins;                // Bins with an id below are opened
+
+    std::vector<std::atomic<int>> block_residuals;  // block * dimensions + h
+    std::vector<std::atomic<float>> block_profiles; // block * dimensions + k
+    std::vector<std::atomic<unsigned>> block_versions; // Incremented by each release
+};
+
+#endif // CONCURRENT_ONLINE_PACKER_HPP
@@ -1,34 +1,266 @@
 #include "lower_bounds.hpp"
+#include "thread_pool.hpp"
 
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 #include <algorithm>
 
 int LB_BPP(const Instance & instance)
 {
-    SizeList sums(instance.getDimensions(), 0);
-    for (Item* item : instance.getItems())
+    // Computed with the other aggregates when the instance is built
+    return instance.getLowerBoundBPP();
+}
+
+
+static inline int popcount64(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for (; word != 0; word &= word - 1)
     {
-        const SizeList& item_sizes = item->getSizes();
-        for (int i = 0; i < instance.getDimensions(); ++i)
+        count++;
+    }
+    return count;
+#endif
+}
+
+static inline int lowestBit(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!(word & 1))
+    {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+/* Bucket queue of the items by degree, with lazy updates.
+ * Degrees only decrease: an item stays in the bucket of an older, higher degree
+ * until this bucket is the highest non empty one, then it moves to the bucket of its degree.
+ * Removed items (degree -1) are dropped the same way.
+ */
+class DegreeBuckets
+{
+public:
+    DegreeBuckets(const std::vector<int>& degrees):
+        degrees(degrees),
+        buckets(degrees.size() + 1),
+        max_degree(0)
+    {
+        for (int v = 0; v < (int)degrees.size(); ++v)
+        {
+            buckets[degrees[v]].push_back(v);
+            max_degree = std::max(max_degree, degrees[v]);
+        }
+    }
+
+    // Lowest item id among the items of highest degree, -1 if there is no item
+    int argmax()
+    {
+        for (; max_degree >= 0; --max_degree)
         {
-            sums[i] += item_sizes[i];
+            std::vector<int>& bucket = buckets[max_degree];
+            int best = -1;
+            int nb_kept = 0;
+            for (const int v : bucket)
+            {
+                if (degrees[v] == max_degree)
+                {
+                    bucket[nb_kept++] = v;
+                    if ((best == -1) || (v < best))
+                    {
+                        best = v;
+                    }
+                }
+                else if (degrees[v] >= 0)
+                {
+                    buckets[degrees[v]].push_back(v);
+                }
+            }
+            bucket.resize(nb_kept);
+            if (best != -1)
+            {
+                return best;
+            }
         }
+        return -1;
     }
 
+    void remove(int v)
+    {
+        degrees[v] = -1;
+    }
+
+    void decrement(int v)
+    {
+        degrees[v]--;
+    }
+
+    void setDegree(int v, int degree)
+    {
+        degrees[v] = degree;
+    }
+
+private:
+    std::vector<int> degrees;
+    std::vector<std::vector<int>> buckets;
+    int max_degree;
+};
+
+// Sizes of the items in dimension h, in increasing order
+static std::vector<int> sortedSizes(const Instance & instance, int h)
+{
+    std::vector<int> sizes;
+    sizes.reserve(instance.getNbItems());
+    for (const Item* item : instance.getItems())
+    {
+        sizes.push_back(item->getSizeDim(h));
+    }
+    std::sort(sizes.begin(), sizes.end());
+    return sizes;
+}
+
+/* Bound L2 of Martello and Toth for the one-dimensional problem in each dimension
+ * ("Lower bounds and reduction procedures for the bin packing problem", 1990).
+ * For 0 <= K <= C/2:
+ *  - the items larger than C-K (J1) and the items larger than C/2 (J2) need one bin each,
+ *    and no item of size K or more fits with an item of J1
+ *  - the items of size in [K, C/2] (J3) fill the room left in the bins of J2 first
+ * L(K) = |J1| + |J2| + max(0, ceil((sum(J3) - (|J2| C - sum(J2))) / C))
+ * Only the sizes of the items are relevant values of K. With the sizes sorted and their
+ * prefix sums, each L(K) is computed with binary searches.
+ */
+int LB_L2(const Instance & instance)
+{
     int LB = 0;
     const SizeList& bin_caps = instance.getBinCapacities();
-    for (int i = 0; i < instance.getDimensions(); ++i)
+    for (int h = 0; h < instance.getDimensions(); ++h)
     {
-        int val = std::ceil(((float)sums[i])/bin_caps[i]);
-        if (LB < val )
+        const long capacity = bin_caps[h];
+        std::vector<int> sizes = sortedSizes(instance, h);
+        std::vector<long> prefix_sums(sizes.size() + 1, 0);
+        for (size_t i = 0; i < sizes.size(); ++i)
         {
-            LB = val;
+            prefix_sums[i + 1] = prefix_sums[i] + sizes[i];
+        }
+
+        // First item larger than C/2
+        const long first_large = std::partition_point(sizes.begin(), sizes.end(),
+            [capacity](int size) { return 2L * size <= capacity; }) - sizes.begin();
+        for (long k_index = -1; k_index < first_large; ++k_index)
+        {
+            if ((k_index > 0) && (sizes[k_index] == sizes[k_index - 1]))
+            {
+                continue;
+            }
+            const long K = (k_index < 0) ? 0 : sizes[k_index];
+            const long first_J1 = std::upper_bound(sizes.begin(), sizes.end(), capacity - K) - sizes.begin();
+            const long first_J3 = std::lower_bound(sizes.begin(), sizes.end(), K) - sizes.begin();
+
+            const long nb_J1 = sizes.size() - first_J1;
+            const long nb_J2 = first_J1 - first_large;
+            const long room_J2 = nb_J2 * capacity - (prefix_sums[first_J1] - prefix_sums[first_large]);
+            const long excess_J3 = (prefix_sums[first_large] - prefix_sums[first_J3]) - room_J2;
+            long val = nb_J1 + nb_J2;
+            if (excess_J3 > 0)
+            {
+                val += (excess_J3 + capacity - 1) / capacity;
+            }
+            LB = std::max(LB, (int)val);
         }
     }
     return LB;
 }
 
+/* Bound of the dual feasible functions of Fekete and Schepers
+ * ("New classes of fast lower bounds for bin packing problems", 2001).
+ * In each dimension, with x the size normalized by the capacity and k >= 1,
+ * u_k(x) = x if (k+1) x is an integer, floor((k+1) x) / k otherwise
+ * maps any set of items fitting in a bin to a set of total size at most 1,
+ * so ceil(sum of u_k(x)) is a lower bound. Computed in integers, scaled by k C.
+ */
+int LB_DFF(const Instance & instance)
+{
+    const int max_k = 20;
+    int LB = 0;
+    const SizeList& bin_caps = instance.getBinCapacities();
+    for (int h = 0; h < instance.getDimensions(); ++h)
+    {
+        const long capacity = bin_caps[h];
+        for (long k = 1; k <= max_k; ++k)
+        {
+            long sum = 0;
+            for (const Item* item : instance.getItems())
+            {
+                const long size = item->getSizeDim(h);
+                if (((k + 1) * size) % capacity == 0)
+                {
+                    sum += k * size;
+                }
+                else
+                {
+                    sum += ((k + 1) * size / capacity) * capacity;
+                }
+            }
+            const long scale = k * capacity;
+            LB = std::max(LB, (int)((sum + scale - 1) / scale));
+        }
+    }
+    return LB;
+}
+
+int LB_max(const Instance & instance, int nb_threads)
+{
+    int LB = std::max(LB_BPP(instance), LB_L2(instance));
+    LB = std::max(LB, LB_DFF(instance));
+    return std::max(LB, LB_clique_implicit(instance, LB_CLIQUE_MAX_GRAPH_ITEMS, nb_threads));
+}
+
+bool isLowerBound(const std::string& name)
+{
+    return std::find(lower_bound_names.begin(), lower_bound_names.end(), name) != lower_bound_names.end();
+}
+
+int computeLowerBound(const std::string& name, const Instance & instance, int nb_threads)
+{
+    if (name == "LB_BPP")
+    {
+        return LB_BPP(instance);
+    }
+    else if (name == "LB_L2")
+    {
+        return LB_L2(instance);
+    }
+    else if (name == "LB_DFF")
+    {
+        return LB_DFF(instance);
+    }
+    else if (name == "LB_clique")
+    {
+        return LB_clique(instance, nb_threads);
+    }
+    else if (name == "LB_clique_implicit")
+    {
+        return LB_clique_implicit(instance, LB_CLIQUE_MAX_GRAPH_ITEMS, nb_threads);
+    }
+    else if (name == "LB_max")
+    {
+        return LB_max(instance, nb_threads);
+    }
+    std::string err_string = "Unknown lower bound name \'" + name + "\'";
+    throw std::runtime_error(err_string);
+}
+
 
 /* The idea is to create a graph of incompatibility between
  * pairs of items.
@@ -36,91 +268,358 @@ int LB_BPP(const Instance & instance)
  * as each item in the clique has to be packed into a different bin.
  * The large clique is computed by means of Johnson's algorithm
  * ("Approximation algorithms for combinatorial problems", 1974
+ *
+ * The adjacency matrix is stored as bitsets of 64 bits words, row i at i * nb_words.
+ * The remaining items are a bitset too: the items kept after picking y are
+ * the remaining items AND the row of y.
+ * The degree of a remaining item is its number of neighbours among the remaining items,
+ * updated either from the removed items or from the kept items, whichever are fewer.
+ * The items picked are the same as with a plain scan of the degrees (argmax_degree).
+ * Returns the positions of the clique items in the list.
+ */
+/* Rows [first_row, last_row) of the adjacency matrix and their degrees.
+ * The sizes are dimension-major, sizes[h * stride + j], padded up to a multiple of 64 items
+ * with values that fit with any item. Item j is incompatible with item i if
+ * sizes[h * stride + j] > capacities[h] - size of i in h, for some h: the comparisons of
+ * a row are done 64 items at a time on contiguous sizes, over column tiles small enough
+ * to stay in cache for all the rows of the task.
+ * Each row is computed in full, so that tasks on different rows write disjoint words.
  */
-int LB_clique(const Instance & instance)
+static void buildIncompatibilityRows(const std::vector<int>& sizes, int stride, const SizeList& capacities,
+                                     int first_row, int last_row, std::vector<uint64_t>& adj,
+                                     std::vector<int>& degrees)
+{
+    const int dimensions = capacities.size();
+    const int nb_words = stride / 64;
+    const int tile_words = std::max(1, 64 / dimensions); // At most 16 KB of sizes per tile
+    std::vector<int> limits((size_t)(last_row - first_row) * dimensions);
+    for (int i = first_row; i < last_row; ++i)
+    {
+        for (int h = 0; h < dimensions; ++h)
+        {
+            limits[(size_t)(i - first_row) * dimensions + h] = capacities[h] - sizes[(size_t)h * stride + i];
+        }
+    }
+
+    for (int first_word = 0; first_word < nb_words; first_word += tile_words)
+    {
+        int last_word = std::min(first_word + tile_words, nb_words);
+        for (int i = first_row; i < last_row; ++i)
+        {
+            const int* row_limits = &limits[(size_t)(i - first_row) * dimensions];
+            for (int w = first_word; w < last_word; ++w)
+            {
+                uint8_t incompatible[64] = {0};
+                for (int h = 0; h < dimensions; ++h)
+                {
+                    const int* column_sizes = &sizes[(size_t)h * stride + w * 64];
+                    const int limit = row_limits[h];
+                    for (int k = 0; k < 64; ++k)
+                    {
+                        incompatible[k] |= (column_sizes[k] > limit);
+                    }
+                }
+                uint64_t word = 0;
+                for (int k = 0; k < 64; ++k)
+                {
+                    word |= (uint64_t)incompatible[k] << k;
+                }
+                adj[(size_t)i * nb_words + w] = word;
+            }
+        }
+    }
+
+    for (int i = first_row; i < last_row; ++i)
+    {
+        uint64_t* rowi = &adj[(size_t)i * nb_words];
+        // An item larger than half the capacity is not incompatible with itself
+        rowi[i / 64] &= ~((uint64_t)1 << (i % 64));
+        degrees[i] = 0;
+        for (int w = 0; w < nb_words; ++w)
+        {
+            degrees[i] += popcount64(rowi[w]);
+        }
+    }
+}
+
+static std::vector<int> greedyClique(const ItemList& items, const SizeList& capacities, int nb_threads)
 {
     // First build the adjacency matrix of items
-    const ItemList& items = instance.getItems();
-    const SizeList& capacities = instance.getBinCapacities();
     int nb_items = items.size();
-    std::vector<std::vector<bool>> adj(items.size(), std::vector<bool>(nb_items, false));
+    int nb_words = (nb_items + 63) / 64;
+    int dimensions = capacities.size();
+    int stride = nb_words * 64;
+    std::vector<uint64_t> adj((size_t)nb_items * nb_words, 0);
     std::vector<int> degrees(nb_items, 0);
 
-    for (int i = 0; i < nb_items; ++i)
+    std::vector<int> sizes((size_t)dimensions * stride, std::numeric_limits<int>::min());
+    for (int j = 0; j < nb_items; ++j)
     {
-        const Item* itemi = items[i];
-        for (int j = i+1; j < nb_items; ++j)
+        for (int h = 0; h < dimensions; ++h)
         {
-            if (check_incompatibility(itemi, items[j], capacities))
-            {
-                // Items are incompatible, update the adjacency matrix
-                adj[i][j] = true;
-                adj[j][i] = true;
+            sizes[(size_t)h * stride + j] = items[j]->getSizeDim(h);
+        }
+    }
 
-                // Update their degrees
-                degrees[i]+=1;
-                degrees[j]+=1;
-            }
+    const int tile_rows = 64;
+    if ((nb_threads == 1) || (nb_items <= tile_rows))
+    {
+        buildIncompatibilityRows(sizes, stride, capacities, 0, nb_items, adj, degrees);
+    }
+    else
+    {
+        ThreadPool pool(nb_threads);
+        std::vector<std::future<void>> tasks;
+        for (int first_row = 0; first_row < nb_items; first_row += tile_rows)
+        {
+            int last_row = std::min(first_row + tile_rows, nb_items);
+            tasks.push_back(pool.submit([&, first_row, last_row]()
+                { buildIncompatibilityRows(sizes, stride, capacities, first_row, last_row, adj, degrees); }));
+        }
+        for (std::future<void>& task : tasks)
+        {
+            task.get();
         }
     }
 
     // Johnson's algo
-    std::vector<int> sub_list; // The clique list
-    std::vector<int> rest_list(nb_items); // The list of remaining items
-
-    // Rest list contains all items
+    DegreeBuckets buckets(degrees);
+    std::vector<uint64_t> rest(nb_words, 0);    // The remaining items
+    std::vector<uint64_t> removed(nb_words, 0); // The items removed in this round
     for (int i = 0; i < nb_items; ++i)
     {
-        rest_list[i] = i;
+        rest[i / 64] |= (uint64_t)1 << (i % 64);
     }
+    int nb_rest = nb_items;
+    std::vector<int> clique; // Positions of the clique items in the list
 
-    // TODO: The complexity of this can probably be greatly improved!
-    while(!rest_list.empty())
+    while (nb_rest > 0)
     {
         // Take the item of highest degree
-        int y = argmax_degree(degrees);
-        if (y == -1)
+        int y = buckets.argmax();
+        clique.push_back(y);
+
+        // Remove all items NOT adjacent to y, y included as it is non adjacent to itself
+        const uint64_t* rowy = &adj[(size_t)y * nb_words];
+        int nb_removed = 0;
+        for (int w = 0; w < nb_words; ++w)
         {
-            // TODO throw an error?
-            return -1;
+            removed[w] = rest[w] & ~rowy[w];
+            rest[w] &= rowy[w];
+            nb_removed += popcount64(removed[w]);
         }
+        nb_rest -= nb_removed;
 
-        // Add y in the clique list
-        sub_list.push_back(y);
-        // This item will be marked to be removed later as it is non adjacent to itself
-
-        std::vector<int> to_remove; // y is non adjacent to itself, it will be removed
-        for (const int item : rest_list)
+        for (int w = 0; w < nb_words; ++w)
         {
-            if (!(adj[y][item]))
+            for (uint64_t bits = removed[w]; bits != 0; bits &= bits - 1)
             {
-                // Remove from rest_list all items NOT adjacent to y
-                to_remove.push_back(item);
+                buckets.remove(w * 64 + lowestBit(bits));
             }
         }
 
-        for (const int item : to_remove)
+        // Update degrees of the remaining items
+        if (nb_removed <= nb_rest)
         {
-            auto it = std::find(rest_list.begin(), rest_list.end(), item);
-            rest_list.erase(it);
-
-            // Update degrees of adjacent items
-            for (int j = 0; j < nb_items; ++j)
+            // Decrement the degrees of the remaining neighbours of each removed item
+            for (int w = 0; w < nb_words; ++w)
+            {
+                for (uint64_t bits = removed[w]; bits != 0; bits &= bits - 1)
+                {
+                    const uint64_t* row = &adj[(size_t)(w * 64 + lowestBit(bits)) * nb_words];
+                    for (int k = 0; k < nb_words; ++k)
+                    {
+                        for (uint64_t neighbours = row[k] & rest[k]; neighbours != 0; neighbours &= neighbours - 1)
+                        {
+                            buckets.decrement(k * 64 + lowestBit(neighbours));
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            // Count the remaining neighbours of each remaining item
+            for (int w = 0; w < nb_words; ++w)
             {
-                if (adj[item][j])
+                for (uint64_t bits = rest[w]; bits != 0; bits &= bits - 1)
                 {
-                    degrees[j]-=1;
+                    int v = w * 64 + lowestBit(bits);
+                    const uint64_t* row = &adj[(size_t)v * nb_words];
+                    int degree = 0;
+                    for (int k = 0; k < nb_words; ++k)
+                    {
+                        degree += popcount64(row[k] & rest[k]);
+                    }
+                    buckets.setDegree(v, degree);
                 }
             }
+        }
+    }
+
+    return clique;
+}
+
+int LB_clique(const Instance & instance, int nb_threads)
+{
+    return greedyClique(instance.getItems(), instance.getBinCapacities(), nb_threads).size();
+}
+
+
+/* Two items are incompatible only if one of them is larger than half the capacity
+ * in some dimension: items small in all dimensions fit pairwise, and a clique
+ * holds at most one of them.
+ * The clique is searched among the large items, then extended with one small item.
+ * Up to max_graph_items large items, this is the greedy of LB_clique on their graph.
+ * Beyond, the graph is not built. For each dimension h, the items larger than half the
+ * capacity in h are a clique, which is extended with the other large items by decreasing
+ * size in h. Whether a candidate is incompatible with the whole clique is first tested
+ * with the smallest sizes of the clique in each dimension, then pair by pair with
+ * check_incompatibility within a budget of checks. The largest clique is kept.
+ * Memory is linear in the number of items.
+ */
 
-            // Deactivate this item
-            degrees[item] = -1;
+// Candidates are added when incompatible with all items of the clique
+// If sorted_dim is a dimension, the clique is sorted by decreasing size in this dimension
+// (the candidates added must keep it sorted): the items of the clique too large to fit
+// with a candidate in this dimension are a prefix, only the others need a pair check
+// A candidate whose test would exceed the budget of pair checks is not added
+static void extendClique(ItemList& clique, std::vector<long>& min_sizes, const ItemList& candidates,
+                         const SizeList& capacities, int sorted_dim, long& budget, bool only_one)
+{
+    int dimensions = capacities.size();
+    for (Item* candidate : candidates)
+    {
+        bool incompatible = clique.empty();
+        for (int h = 0; (h < dimensions) && !incompatible; ++h)
+        {
+            incompatible = (candidate->getSizeDim(h) + min_sizes[h] > capacities[h]);
+        }
+
+        auto first_to_check = clique.begin();
+        if (!incompatible && (sorted_dim >= 0))
+        {
+            int max_fitting = capacities[sorted_dim] - candidate->getSizeDim(sorted_dim);
+            first_to_check = std::partition_point(clique.begin(), clique.end(), [&](const Item* item)
+                                                  { return item->getSizeDim(sorted_dim) > max_fitting; });
+        }
+        if (!incompatible && (budget >= clique.end() - first_to_check))
+        {
+            // The last items added are the most likely to be compatible, check them first
+            incompatible = true;
+            for (auto it = clique.end(); (it != first_to_check) && incompatible; )
+            {
+                --it;
+                budget--;
+                incompatible = check_incompatibility(candidate, *it, capacities);
+            }
+        }
+        if (incompatible)
+        {
+            clique.push_back(candidate);
+            for (int h = 0; h < dimensions; ++h)
+            {
+                min_sizes[h] = std::min(min_sizes[h], (long)candidate->getSizeDim(h));
+            }
+            if (only_one)
+            {
+                return;
+            }
         }
     }
+}
 
-    return sub_list.size();
+static std::vector<long> cliqueMinSizes(const ItemList& clique, const SizeList& capacities)
+{
+    std::vector<long> min_sizes(capacities.size(), std::numeric_limits<int>::max());
+    for (const Item* item : clique)
+    {
+        for (int h = 0; h < (int)capacities.size(); ++h)
+        {
+            min_sizes[h] = std::min(min_sizes[h], (long)item->getSizeDim(h));
+        }
+    }
+    return min_sizes;
 }
 
+int LB_clique_implicit(const Instance & instance, int max_graph_items, int nb_threads)
+{
+    const ItemList& items = instance.getItems();
+    const SizeList& capacities = instance.getBinCapacities();
+    int dimensions = capacities.size();
+
+    // Without large items, all items fit pairwise
+    bool has_large_items = false;
+    for (int h = 0; h < dimensions; ++h)
+    {
+        has_large_items = has_large_items || (2 * instance.getMaxSizes()[h] > capacities[h]);
+    }
+    if (!has_large_items)
+    {
+        return std::min((int)items.size(), 1);
+    }
+
+    ItemList large_items;
+    ItemList small_items;
+    for (Item* item : items)
+    {
+        bool large = false;
+        for (int h = 0; (h < dimensions) && !large; ++h)
+        {
+            large = (2 * item->getSizeDim(h) > capacities[h]);
+        }
+        (large ? large_items : small_items).push_back(item);
+    }
+
+    // Small items are tried by decreasing largest normalized size
+    auto max_norm_size = [&](const Item* item)
+    {
+        float max_size = 0.0f;
+        for (int h = 0; h < dimensions; ++h)
+        {
+            max_size = std::max(max_size, ((float)item->getSizeDim(h)) / capacities[h]);
+        }
+        return max_size;
+    };
+    std::stable_sort(small_items.begin(), small_items.end(), [&](const Item* a, const Item* b)
+                     { return max_norm_size(a) > max_norm_size(b); });
+
+    const long budget_per_search = 64L * items.size();
+    if ((int)large_items.size() <= max_graph_items)
+    {
+        ItemList clique;
+        for (const int pos : greedyClique(large_items, capacities, nb_threads))
+        {
+            clique.push_back(large_items[pos]);
+        }
+        std::vector<long> min_sizes = cliqueMinSizes(clique, capacities);
+        long budget = budget_per_search;
+        extendClique(clique, min_sizes, small_items, capacities, -1, budget, true);
+        return clique.size();
+    }
+
+    int best = 0;
+    ItemList clique;
+    ItemList candidates;
+    for (int h = 0; h < dimensions; ++h)
+    {
+        // Sorted by decreasing size in h, the items larger than half the capacity come first
+        candidates = large_items;
+        std::stable_sort(candidates.begin(), candidates.end(), [h](const Item* a, const Item* b)
+                         { return a->getSizeDim(h) > b->getSizeDim(h); });
+        auto first_candidate = std::find_if(candidates.begin(), candidates.end(), [&](const Item* item)
+                                            { return 2 * item->getSizeDim(h) <= capacities[h]; });
+        clique.assign(candidates.begin(), first_candidate);
+        candidates.erase(candidates.begin(), first_candidate);
+
+        std::vector<long> min_sizes = cliqueMinSizes(clique, capacities);
+        long budget = budget_per_search;
+        extendClique(clique, min_sizes, candidates, capacities, h, budget, false);
+        extendClique(clique, min_sizes, small_items, capacities, h, budget, true);
+        best = std::max(best, (int)clique.size());
+    }
+    return best;
+}
 
 bool check_incompatibility(const Item* itema, const Item* itemb, const SizeList& capacities)
 {
@@ -135,7 +634,7 @@ bool check_incompatibility(const Item* itema, const Item* itemb, const SizeList&
     return false;
 }
 
-int argmax_degree(const std::vector<int> degrees)
+int argmax_degree(const std::vector<int>& degrees)
 {
     int max = -1;
     int argmax = -1;
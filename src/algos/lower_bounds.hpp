@@ -5,11 +5,38 @@
 #include <instance.hpp>
 using namespace vectorpack;
 
+#include <string>
+#include <vector>
+
+// Names of the lower bounds accepted by computeLowerBound (and the CLI)
+const static std::vector<std::string> lower_bound_names = {
+    "LB_BPP", "LB_L2", "LB_DFF", "LB_clique", "LB_clique_implicit", "LB_max"
+};
+
+bool isLowerBound(const std::string& name);
+
+// Throws if the name is not a lower bound
+int computeLowerBound(const std::string& name, const Instance & instance, int nb_threads = 1);
+
 int LB_BPP(const Instance & instance);
 
-int LB_clique(const Instance & instance);
+// One-dimensional bounds in each dimension, the maximum over the dimensions is returned
+int LB_L2(const Instance & instance);  // Martello and Toth L2
+int LB_DFF(const Instance & instance); // Dual feasible functions of Fekete and Schepers
+
+// Maximum of LB_BPP, LB_L2, LB_DFF and LB_clique_implicit
+int LB_max(const Instance & instance, int nb_threads = 1);
+
+// The incompatibility graph is built with nb_threads threads (0 for the number of hardware threads)
+int LB_clique(const Instance & instance, int nb_threads = 1);
+
+// Clique bound without the quadratic incompatibility matrix, for large instances
+// The graph is only built on the items larger than half the capacity in some dimension,
+// and only if there are at most max_graph_items of them
+const int LB_CLIQUE_MAX_GRAPH_ITEMS = 10000;
+int LB_clique_implicit(const Instance & instance, int max_graph_items = LB_CLIQUE_MAX_GRAPH_ITEMS, int nb_threads = 1);
 
 bool check_incompatibility(const Item* itema, const Item* itemb, const SizeList& capacities);
-int argmax_degree(const std::vector<int> degrees);
+int argmax_degree(const std::vector<int>& degrees);
 
 #endif // LOWER_BOUNDS_HPP
@@ -0,0 +1,433 @@
+#include "online_packer.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+OnlinePacker::OnlinePacker(const SizeList& capacities, const ONLINE_POLICY policy,
+                           const MEASURE measure, const FloatList& weights):
+    capacities(capacities),
+    dimensions(capacities.size()),
+    policy(policy),
+    measure(measure),
+    weights_list(weights),
+    nb_used_bins(0),
+    item_profile(capacities.size()),
+    index_size(0)
+{
+    if (dimensions <= 0)
+    {
+        throw std::runtime_error("The online packer needs at least one dimension");
+    }
+    if (weights_list.empty())
+    {
+        weights_list = FloatList(dimensions, 1.0);
+    }
+    if ((int)weights_list.size() != dimensions)
+    {
+        std::string s = "Online packer with " + std::to_string(dimensions) + " dimensions but "
+            + std::to_string(weights_list.size()) + " weights";
+        throw std::runtime_error(s);
+    }
+
+    growIndex();
+}
+
+OnlinePacker::~OnlinePacker()
+{
+    for (Bin* bin : bins)
+    {
+        delete bin;
+    }
+    for (auto& item_pair : items)
+    {
+        delete item_pair.second.item;
+    }
+}
+
+int OnlinePacker::place(int item_id, const SizeList& sizes)
+{
+    if ((int)sizes.size() != dimensions)
+    {
+        std::string s = "Item " + std::to_string(item_id) + " has " + std::to_string(sizes.size())
+            + " dimensions instead of " + std::to_string(dimensions);
+        throw std::runtime_error(s);
+    }
+    if (items.count(item_id) > 0)
+    {
+        std::string s = "Item " + std::to_string(item_id) + " is already placed";
+        throw std::runtime_error(s);
+    }
+
+    computeProfile(sizes, item_profile.data());
+    int slot = findBin(sizes, item_profile);
+    if (slot < 0)
+    {
+        for (int h = 0; h < dimensions; ++h)
+        {
+            if (sizes[h] > capacities[h])
+            {
+                std::string s = "Item " + std::to_string(item_id) + " does not fit in an empty bin";
+                throw std::runtime_error(s);
+            }
+        }
+        slot = openBin()->getId();
+    }
+
+    SizeList item_sizes(sizes);
+    FloatList norm_sizes(dimensions);
+    for (int h = 0; h < dimensions; ++h)
+    {
+        norm_sizes[h] = ((float)sizes[h]) / capacities[h];
+    }
+    Item* item = new Item(item_id, item_sizes, norm_sizes);
+    items[item_id] = {item, slot};
+
+    Bin* bin = bins[slot];
+    bin->addItem(item);
+    updateBinMeasure(bin);
+    updateIndex(slot);
+    return slot;
+}
+
+int OnlinePacker::remove(int item_id)
+{
+    auto it = items.find(item_id);
+    if (it == items.end())
+    {
+        std::string s = "Item " + std::to_string(item_id) + " is not placed";
+        throw std::runtime_error(s);
+    }
+    Item* item = it->second.item;
+    int slot = it->second.bin_id;
+    items.erase(it);
+
+    Bin* bin = bins[slot];
+    bin->removeItem(item);
+    delete item;
+
+    if (bin->getAllocList().empty())
+    {
+        releaseBin(slot);
+    }
+    else
+    {
+        updateBinMeasure(bin);
+        updateIndex(slot);
+    }
+    return slot;
+}
+
+int OnlinePacker::getNbBins() const
+{
+    return nb_used_bins;
+}
+
+int OnlinePacker::getNbItems() const
+{
+    return items.size();
+}
+
+const BinList& OnlinePacker::getBins() const
+{
+    return bins;
+}
+
+const SizeList& OnlinePacker::getCapacities() const
+{
+    return capacities;
+}
+
+int OnlinePacker::getDimensions() const
+{
+    return dimensions;
+}
+
+
+void OnlinePacker::computeProfile(const SizeList& values, float* profile) const
+{
+    // The same computation for items and bins keeps the comparisons exact:
+    // the division is monotonic, and sorting preserves the componentwise order
+    for (int h = 0; h < dimensions; ++h)
+    {
+        profile[h] = ((float)values[h]) / capacities[h];
+    }
+    std::sort(profile, profile + dimensions);
+}
+
+int OnlinePacker::findBin(const SizeList& sizes, const FloatList& profile) const
+{
+    if (policy == ONLINE_POLICY::FIRST_FIT)
+    {
+        return findFirstFit(1, sizes, profile);
+    }
+
+    int best_slot = -1;
+    float best_key = std::numeric_limits<float>::max();
+    findBestFit(1, sizes, profile, best_slot, best_key);
+    return best_slot;
+}
+
+bool OnlinePacker::nodeMayFit(int node, const SizeList& sizes, const FloatList& profile) const
+{
+    // Both maxima may come from different bins: this is only a necessary condition
+    const int* residuals = &node_residuals[node * dimensions];
+    const float* node_profile = &node_profiles[node * dimensions];
+    for (int h = 0; h < dimensions; ++h)
+    {
+        if ((residuals[h] < sizes[h]) || (node_profile[h] < profile[h]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool OnlinePacker::slotFits(int slot, const SizeList& sizes) const
+{
+    const int* residuals = &slot_residuals[slot * dimensions];
+    for (int h = 0; h < dimensions; ++h)
+    {
+        if (residuals[h] < sizes[h])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+float OnlinePacker::nodeKey(int node) const
+{
+    if (policy == ONLINE_POLICY::WORST_FIT)
+    {
+        return -node_max_measures[node];
+    }
+    return node_min_measures[node];
+}
+
+float OnlinePacker::slotKey(int slot) const
+{
+    if (policy == ONLINE_POLICY::WORST_FIT)
+    {
+        return -slot_measures[slot];
+    }
+    return slot_measures[slot];
+}
+
+// Lowest slot of the subtree where the item fits
+int OnlinePacker::findFirstFit(int node, const SizeList& sizes, const FloatList& profile) const
+{
+    if (!nodeMayFit(node, sizes, profile))
+    {
+        return -1;
+    }
+    if (node >= index_size)
+    {
+        int first_slot = (node - index_size) * BLOCK_SIZE;
+        int end_slot = std::min(first_slot + BLOCK_SIZE, (int)bins.size());
+        for (int slot = first_slot; slot < end_slot; ++slot)
+        {
+            if (slotFits(slot, sizes))
+            {
+                return slot;
+            }
+        }
+        return -1;
+    }
+    int slot = findFirstFit(2 * node, sizes, profile);
+    if (slot < 0)
+    {
+        slot = findFirstFit(2 * node + 1, sizes, profile);
+    }
+    return slot;
+}
+
+// Branch and bound on the key of the bins, the child with the best bound is explored first
+// A subtree is pruned when its bound is worse than the best bin found so far
+// Slots are scanned in increasing order within a block, and ties keep the lowest slot
+void OnlinePacker::findBestFit(int node, const SizeList& sizes, const FloatList& profile,
+                               int& best_slot, float& best_key) const
+{
+    if (!nodeMayFit(node, sizes, profile))
+    {
+        return;
+    }
+    float bound = nodeKey(node);
+    if ((best_slot >= 0) && (bound > best_key))
+    {
+        return;
+    }
+    if (node >= index_size)
+    {
+        int first_slot = (node - index_size) * BLOCK_SIZE;
+        int end_slot = std::min(first_slot + BLOCK_SIZE, (int)bins.size());
+        for (int slot = first_slot; slot < end_slot; ++slot)
+        {
+            float key = slotKey(slot);
+            if (((best_slot < 0) || (key < best_key) || ((key == best_key) && (slot < best_slot)))
+                && slotFits(slot, sizes))
+            {
+                best_slot = slot;
+                best_key = key;
+            }
+        }
+        return;
+    }
+
+    int left = 2 * node;
+    int right = left + 1;
+    if (nodeKey(right) < nodeKey(left))
+    {
+        findBestFit(right, sizes, profile, best_slot, best_key);
+        findBestFit(left, sizes, profile, best_slot, best_key);
+    }
+    else
+    {
+        findBestFit(left, sizes, profile, best_slot, best_key);
+        findBestFit(right, sizes, profile, best_slot, best_key);
+    }
+}
+
+
+Bin* OnlinePacker::openBin()
+{
+    nb_used_bins += 1;
+    if (!released_slots.empty())
+    {
+        // The bin was reset when released, the index is updated once the item is added
+        int slot = released_slots.top();
+        released_slots.pop();
+        return bins[slot];
+    }
+
+    if ((int)bins.size() == index_size * BLOCK_SIZE)
+    {
+        growIndex();
+    }
+    Bin* bin = new Bin(bins.size(), capacities);
+    bins.push_back(bin);
+    slot_residuals.insert(slot_residuals.end(), dimensions, -1);
+    slot_profiles.insert(slot_profiles.end(), dimensions, -1.0);
+    slot_measures.push_back(0.0);
+    return bin;
+}
+
+void OnlinePacker::releaseBin(int slot)
+{
+    bins[slot]->reset();
+    std::fill(&slot_residuals[slot * dimensions], &slot_residuals[(slot + 1) * dimensions], -1);
+    std::fill(&slot_profiles[slot * dimensions], &slot_profiles[(slot + 1) * dimensions], -1.0);
+    nb_used_bins -= 1;
+    released_slots.push(slot);
+    updateBlock(slot / BLOCK_SIZE);
+}
+
+void OnlinePacker::updateBinMeasure(Bin* bin)
+{
+    // Same measures as AlgoBFD_T1
+    switch(measure)
+    {
+    case MEASURE::LINF:
+        bin->setMeasure(utilBinMeasure<MEASURE::LINF>(weights_list, bin, dimensions));
+        break;
+    case MEASURE::L1:
+        bin->setMeasure(utilBinMeasure<MEASURE::L1>(weights_list, bin, dimensions));
+        break;
+    case MEASURE::L2:
+        bin->setMeasure(utilBinMeasure<MEASURE::L2>(weights_list, bin, dimensions));
+        break;
+    case MEASURE::L2_LOAD:
+        bin->setMeasure(utilBinMeasure<MEASURE::L2_LOAD>(weights_list, bin, dimensions));
+        break;
+    }
+}
+
+void OnlinePacker::updateIndex(int slot)
+{
+    const Bin* bin = bins[slot];
+    for (int h = 0; h < dimensions; ++h)
+    {
+        slot_residuals[slot * dimensions + h] = bin->getAvailableCapDim(h);
+    }
+    // The normalized residual capacities of the bin are those computeProfile would compute
+    const FloatList& norm_residuals = bin->getNormAvailableCaps();
+    float* profile = &slot_profiles[slot * dimensions];
+    std::copy(norm_residuals.begin(), norm_residuals.end(), profile);
+    std::sort(profile, profile + dimensions);
+    slot_measures[slot] = bin->getMeasure();
+    updateBlock(slot / BLOCK_SIZE);
+}
+
+void OnlinePacker::updateBlock(int block)
+{
+    setLeaf(block);
+    for (int node = (index_size + block) / 2; node >= 1; node /= 2)
+    {
+        mergeChildren(node);
+    }
+}
+
+void OnlinePacker::setLeaf(int block)
+{
+    int node = index_size + block;
+    int* residuals = &node_residuals[node * dimensions];
+    float* profile = &node_profiles[node * dimensions];
+    float min_measure = std::numeric_limits<float>::max();
+    float max_measure = std::numeric_limits<float>::lowest();
+    std::fill(residuals, residuals + dimensions, -1);
+    std::fill(profile, profile + dimensions, -1.0);
+
+    int first_slot = block * BLOCK_SIZE;
+    int end_slot = std::min(first_slot + BLOCK_SIZE, (int)bins.size());
+    for (int slot = first_slot; slot < end_slot; ++slot)
+    {
+        if (slot_residuals[slot * dimensions] < 0)
+        {
+            continue; // Released slot
+        }
+        for (int h = 0; h < dimensions; ++h)
+        {
+            residuals[h] = std::max(residuals[h], slot_residuals[slot * dimensions + h]);
+            profile[h] = std::max(profile[h], slot_profiles[slot * dimensions + h]);
+        }
+        min_measure = std::min(min_measure, slot_measures[slot]);
+        max_measure = std::max(max_measure, slot_measures[slot]);
+    }
+    node_min_measures[node] = min_measure;
+    node_max_measures[node] = max_measure;
+}
+
+void OnlinePacker::mergeChildren(int node)
+{
+    int left = 2 * node;
+    int right = left + 1;
+    for (int h = 0; h < dimensions; ++h)
+    {
+        node_residuals[node * dimensions + h] = std::max(node_residuals[left * dimensions + h],
+                                                         node_residuals[right * dimensions + h]);
+        node_profiles[node * dimensions + h] = std::max(node_profiles[left * dimensions + h],
+                                                        node_profiles[right * dimensions + h]);
+    }
+    node_min_measures[node] = std::min(node_min_measures[left], node_min_measures[right]);
+    node_max_measures[node] = std::max(node_max_measures[left], node_max_measures[right]);
+}
+
+void OnlinePacker::growIndex()
+{
+    index_size = std::max(1, 2 * index_size);
+    node_residuals.assign(2 * index_size * dimensions, -1);
+    node_profiles.assign(2 * index_size * dimensions, -1.0);
+    node_min_measures.assign(2 * index_size, std::numeric_limits<float>::max());
+    node_max_measures.assign(2 * index_size, std::numeric_limits<float>::lowest());
+
+    // Rebuild from the current bins, in O(number of bins) amortized over the doublings
+    int nb_blocks = (bins.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    for (int block = 0; block < nb_blocks; ++block)
+    {
+        setLeaf(block);
+    }
+    for (int node = index_size - 1; node >= 1; --node)
+    {
+        mergeChildren(node);
+    }
+}
@@ -0,0 +1,124 @@
+#ifndef ONLINE_PACKER_HPP
+#define ONLINE_PACKER_HPP
+
+#include "item.hpp"
+#include "bin.hpp"
+#include "weights_measures_scores.hpp"
+
+#include <functional>
+#include <map>
+#include <queue>
+#include <string>
+#include <unordered_map>
+
+using namespace vectorpack;
+
+// How the online packer chooses a bin among the bins where the item fits
+enum class ONLINE_POLICY {
+     FIRST_FIT // Lowest bin id
+    ,BEST_FIT  // Lowest bin measure, ties broken by lowest bin id
+    ,WORST_FIT // Highest bin measure, ties broken by lowest bin id
+};
+
+const static std::map<std::string, ONLINE_POLICY> map_str_to_online_policy = {
+    { "FF", ONLINE_POLICY::FIRST_FIT },
+    { "BF", ONLINE_POLICY::BEST_FIT },
+    { "WF", ONLINE_POLICY::WORST_FIT },
+};
+
+
+// Packer of items arriving and leaving one at a time in a live set of bins
+// A bin is released when its last item leaves, and its id is re-used by the next opened bin
+// Bin measures are computed as in AlgoBFD_T1 from the residual capacities,
+// with static weights given at construction (dynamic weights need the whole instance)
+//
+// The bins are indexed by a segment tree over blocks of BLOCK_SIZE consecutive bin ids,
+// searched by branch and bound. Each node keeps, over its bins:
+// - the maximum residual capacity in each dimension
+// - the maximum of each order statistic of the normalized residual capacities
+//   (smallest, second smallest...): if an item fits in a bin, the k-th smallest
+//   normalized residual of the bin is at least the k-th smallest normalized size of
+//   the item. This prunes the nearly full bins, which the per-dimension maxima do not
+// - the minimum and maximum bin measure
+// The bins of a block are scanned linearly, with their residual capacities stored contiguously
+class OnlinePacker
+{
+public:
+    // An empty weights list means unit weights
+    OnlinePacker(const SizeList& capacities, const ONLINE_POLICY policy,
+                 const MEASURE measure = MEASURE::L1, const FloatList& weights = FloatList());
+    virtual ~OnlinePacker();
+
+    OnlinePacker(const OnlinePacker&) = delete;
+    OnlinePacker& operator=(const OnlinePacker&) = delete;
+
+    // Place the item in a bin, opening a new bin if it fits nowhere
+    // Returns the id of the chosen bin
+    // Throws if the item id is already placed or if the item does not fit in an empty bin
+    int place(int item_id, const SizeList& sizes);
+
+    // Remove the item from its bin, releasing the bin if it becomes empty
+    // Returns the id of the bin, throws if the item is not placed
+    int remove(int item_id);
+
+    int getNbBins() const; // Number of bins in use
+    int getNbItems() const;
+    const BinList& getBins() const; // Indexed by bin id, the released bins are empty
+    const SizeList& getCapacities() const;
+    int getDimensions() const;
+
+protected:
+    static const int BLOCK_SIZE = 16; // Number of bins in a leaf of the index
+
+    // The profile of an item or a bin is its list of normalized sizes or residual capacities, sorted
+    void computeProfile(const SizeList& values, float* profile) const;
+
+    int findBin(const SizeList& sizes, const FloatList& profile) const; // -1 if the item fits in no bin
+    int findFirstFit(int node, const SizeList& sizes, const FloatList& profile) const;
+    void findBestFit(int node, const SizeList& sizes, const FloatList& profile,
+                     int& best_slot, float& best_key) const;
+    bool nodeMayFit(int node, const SizeList& sizes, const FloatList& profile) const;
+    bool slotFits(int slot, const SizeList& sizes) const;
+    float nodeKey(int node) const; // Bound on the key of the bins of the node, lower is better
+    float slotKey(int slot) const;
+
+    Bin* openBin(); // Re-uses the lowest released bin id if any
+    void releaseBin(int slot);
+    void updateBinMeasure(Bin* bin);
+    void updateIndex(int slot); // After a change of the bin in this slot
+    void updateBlock(int block); // After a change of the slots of the block
+    void setLeaf(int block);
+    void mergeChildren(int node);
+    void growIndex();           // Double the number of blocks
+
+    struct PlacedItem
+    {
+        Item* item;
+        int bin_id;
+    };
+
+    const SizeList capacities;
+    const int dimensions;
+    const ONLINE_POLICY policy;
+    const MEASURE measure;
+    FloatList weights_list;
+
+    BinList bins; // Indexed by bin id
+    int nb_used_bins;
+    std::priority_queue<int, std::vector<int>, std::greater<int>> released_slots; // Lowest first
+    std::unordered_map<int, PlacedItem> items; // Placed items, by id
+    FloatList item_profile; // Profile of the item being placed
+    std::vector<int> slot_residuals; // Copy of the residual capacities of the bins, slot * dimensions + h
+    FloatList slot_profiles;         // slot * dimensions + k
+    FloatList slot_measures;         // Copy of the bin measures
+
+    // Segment tree with root 1, the leaf of block b is at index_size + b
+    // Released slots and empty leaves have a residual capacity of -1 so that nothing fits
+    int index_size; // Number of blocks, a power of 2
+    std::vector<int> node_residuals; // node * dimensions + h
+    FloatList node_profiles;         // node * dimensions + k
+    FloatList node_min_measures;
+    FloatList node_max_measures;
+};
+
+#endif // ONLINE_PACKER_HPP
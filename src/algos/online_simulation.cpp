@@ -0,0 +1,154 @@
+#include "online_simulation.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using std::chrono::steady_clock;
+
+static std::string traceError(const std::string& filename, int line_number, const std::string& message)
+{
+    return "Trace " + filename + ", line " + std::to_string(line_number) + ": " + message;
+}
+
+// Next line which is neither empty nor a comment, false at the end of the file
+static bool nextTraceLine(std::ifstream& f, std::string& line, int& line_number)
+{
+    while (std::getline(f, line))
+    {
+        line_number++;
+        size_t first = line.find_first_not_of(" \t\r");
+        if ((first != std::string::npos) && (line[first] != '#'))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+Trace readTrace(const std::string& filename)
+{
+    std::ifstream f(filename);
+    if (!f.is_open())
+    {
+        std::string s = "Could not open trace file " + filename;
+        throw std::runtime_error(s);
+    }
+
+    Trace trace;
+    std::string line;
+    int line_number = 0;
+
+    if (!nextTraceLine(f, line, line_number) || !(std::istringstream(line) >> trace.dimensions)
+        || (trace.dimensions <= 0))
+    {
+        throw std::runtime_error(traceError(filename, line_number, "expected the number of dimensions"));
+    }
+
+    trace.capacities = SizeList(trace.dimensions);
+    if (!nextTraceLine(f, line, line_number))
+    {
+        throw std::runtime_error(traceError(filename, line_number, "expected the bin capacities"));
+    }
+    std::istringstream capacities_stream(line);
+    for (int& capacity : trace.capacities)
+    {
+        if (!(capacities_stream >> capacity) || (capacity <= 0))
+        {
+            throw std::runtime_error(traceError(filename, line_number, "expected the bin capacities"));
+        }
+    }
+
+    double last_time = 0.0;
+    while (nextTraceLine(f, line, line_number))
+    {
+        std::istringstream ss(line);
+        TraceEvent event;
+        std::string type;
+        if (!(ss >> event.time >> type >> event.item_id) || ((type != "A") && (type != "D")))
+        {
+            throw std::runtime_error(traceError(filename, line_number, "expected '<time> A <id> <sizes>' or '<time> D <id>'"));
+        }
+        if (!trace.events.empty() && (event.time < last_time))
+        {
+            throw std::runtime_error(traceError(filename, line_number, "events are not in non-decreasing time"));
+        }
+        last_time = event.time;
+
+        event.arrival = (type == "A");
+        event.sizes_index = -1;
+        if (event.arrival)
+        {
+            event.sizes_index = trace.sizes.size() / trace.dimensions;
+            for (int h = 0; h < trace.dimensions; ++h)
+            {
+                int size;
+                if (!(ss >> size) || (size < 0))
+                {
+                    throw std::runtime_error(traceError(filename, line_number, "expected " + std::to_string(trace.dimensions) + " item sizes"));
+                }
+                trace.sizes.push_back(size);
+            }
+        }
+        trace.events.push_back(event);
+    }
+    return trace;
+}
+
+
+SimulationSummary simulateTrace(const Trace& trace, OnlinePacker& packer, std::ostream* output)
+{
+    if (packer.getCapacities() != trace.capacities)
+    {
+        throw std::runtime_error("The bin capacities of the online packer and of the trace differ");
+    }
+
+    struct TimePoint
+    {
+        double time;
+        int nb_bins;
+        int nb_items;
+    };
+
+    SimulationSummary summary = {0, 0, 0, 0, 0.0};
+    std::vector<TimePoint> time_points; // Written after the replay, so that the output is not timed
+    SizeList sizes(trace.dimensions);
+    int nb_events = trace.events.size();
+
+    steady_clock::time_point start = steady_clock::now();
+    for (int i = 0; i < nb_events; ++i)
+    {
+        const TraceEvent& event = trace.events[i];
+        if (event.arrival)
+        {
+            const int* event_sizes = &trace.sizes[event.sizes_index * trace.dimensions];
+            sizes.assign(event_sizes, event_sizes + trace.dimensions);
+            packer.place(event.item_id, sizes);
+            summary.nb_arrivals++;
+        }
+        else
+        {
+            packer.remove(event.item_id);
+            summary.nb_departures++;
+        }
+        summary.peak_bins = std::max(summary.peak_bins, packer.getNbBins());
+
+        if ((output != nullptr) && ((i + 1 == nb_events) || (trace.events[i + 1].time != event.time)))
+        {
+            time_points.push_back({event.time, packer.getNbBins(), packer.getNbItems()});
+        }
+    }
+    summary.replay_ms = std::chrono::duration<double, std::milli>(steady_clock::now() - start).count();
+    summary.nb_events = nb_events;
+
+    if (output != nullptr)
+    {
+        *output << "time,bins,items\n";
+        for (const TimePoint& point : time_points)
+        {
+            *output << point.time << "," << point.nb_bins << "," << point.nb_items << "\n";
+        }
+    }
+    return summary;
+}
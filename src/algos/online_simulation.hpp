@@ -0,0 +1,54 @@
+#ifndef ONLINE_SIMULATION_HPP
+#define ONLINE_SIMULATION_HPP
+
+#include "online_packer.hpp"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace vectorpack;
+
+// One event of an arrival/departure trace
+struct TraceEvent
+{
+    double time;
+    bool arrival;
+    int item_id;
+    int sizes_index; // Index of the sizes of an arriving item in Trace::sizes, -1 for departures
+};
+
+// Trace of a dynamic bin packing workload
+// File format:
+//  - first line: the number of dimensions d
+//  - second line: the d bin capacities
+//  - then one event per line, in non-decreasing time:
+//      <time> A <item_id> <size_1> ... <size_d>   (arrival)
+//      <time> D <item_id>                         (departure)
+//  Empty lines and lines starting with '#' are ignored
+struct Trace
+{
+    int dimensions;
+    SizeList capacities;
+    std::vector<TraceEvent> events;
+    SizeList sizes; // Sizes of the arrivals, sizes_index * dimensions + h
+};
+
+Trace readTrace(const std::string& filename);
+
+// Result of the replay of a trace
+struct SimulationSummary
+{
+    long nb_events;
+    long nb_arrivals;
+    long nb_departures;
+    int peak_bins;      // Maximum number of bins in use
+    double replay_ms;   // Time spent in the packer, without the output
+};
+
+// Replay all events of the trace with the packer
+// After the last event of each time, a line "<time>,<bins in use>,<items>" is written to
+// the output (preceded by a CSV header), unless output is nullptr
+SimulationSummary simulateTrace(const Trace& trace, OnlinePacker& packer, std::ostream* output);
+
+#endif // ONLINE_SIMULATION_HPP
@@ -0,0 +1,131 @@
+#include "portfolio.hpp"
+#include "algo_utils.hpp"
+#include "thread_pool.hpp"
+
+#include <exception>
+#include <future>
+
+Portfolio::Portfolio(const Instance &instance, const std::vector<std::string>& algo_names):
+    instance(instance),
+    algo_names(algo_names),
+    time_limit_ms(0.0),
+    best_algo(nullptr),
+    best_index(-1)
+{ }
+
+Portfolio::~Portfolio()
+{
+    if (best_algo != nullptr)
+    {
+        delete best_algo;
+    }
+}
+
+int Portfolio::run(int LB, int nb_threads)
+{
+    if (best_algo != nullptr)
+    {
+        delete best_algo;
+        best_algo = nullptr;
+    }
+    best_index = -1;
+
+    results.clear();
+    results.resize(algo_names.size());
+
+    // The FF upper bound is shared by all multi-bin algorithms
+    int UB = -1;
+    for (const std::string& algo_name : algo_names)
+    {
+        if (isMultiBinAlgo(algo_name))
+        {
+            UB = computeUpperBoundFF(instance, LB);
+            break;
+        }
+    }
+
+    ThreadPool pool(nb_threads);
+    std::vector<std::future<void>> jobs;
+    jobs.reserve(algo_names.size());
+    for (int i = 0; i < (int)algo_names.size(); ++i)
+    {
+        jobs.push_back(pool.submit([this, i, LB, UB]() { runAlgo(i, LB, UB); }));
+    }
+    for (std::future<void>& job : jobs)
+    {
+        job.get();
+    }
+
+    return getBestSolution();
+}
+
+void Portfolio::runAlgo(int index, int LB, int UB)
+{
+    const std::string& algo_name = algo_names[index];
+    PortfolioResult& result = results[index];
+    result.algo_name = algo_name;
+    result.solution = -1;
+
+    BaseAlgo* algo = nullptr;
+    try {
+        algo = createAlgo(algo_name, instance);
+        algo->setTimeLimit(time_limit_ms);
+        result.solution = solveWithAlgo(algo, algo_name, LB, UB);
+    }
+    catch (std::exception& e)
+    {
+        result.error = e.what();
+    }
+
+    if ((algo != nullptr) && (result.solution > 0))
+    {
+        std::lock_guard<std::mutex> lock(best_mutex);
+        int best_solution = getBestSolution();
+        if ((best_algo == nullptr) || (result.solution < best_solution)
+            || ((result.solution == best_solution) && (index < best_index)))
+        {
+            std::swap(algo, best_algo);
+            best_index = index;
+        }
+    }
+
+    // Only the allocation of the best algorithm is kept in memory
+    if (algo != nullptr)
+    {
+        delete algo;
+    }
+}
+
+void Portfolio::setTimeLimit(double time_limit_ms)
+{
+    this->time_limit_ms = time_limit_ms;
+}
+
+const std::vector<PortfolioResult>& Portfolio::getResults() const
+{
+    return results;
+}
+
+int Portfolio::getBestSolution() const
+{
+    if (best_index < 0)
+    {
+        return -1;
+    }
+    return results[best_index].solution;
+}
+
+const std::string& Portfolio::getBestAlgoName() const
+{
+    static const std::string none;
+    if (best_index < 0)
+    {
+        return none;
+    }
+    return algo_names[best_index];
+}
+
+BaseAlgo* Portfolio::getBestAlgo() const
+{
+    return best_algo;
+}
@@ -0,0 +1,54 @@
+#ifndef PORTFOLIO_HPP
+#define PORTFOLIO_HPP
+
+#include "base_algo.hpp"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace vectorpack;
+
+// Result of one algorithm of the portfolio
+struct PortfolioResult
+{
+    std::string algo_name;
+    int solution;      // Number of bins, -1 if no solution was found
+    std::string error; // Error message if the algorithm failed, empty otherwise
+};
+
+// Run a list of algorithms concurrently on the same instance
+// and keep the best solution
+class Portfolio
+{
+public:
+    Portfolio(const Instance &instance, const std::vector<std::string>& algo_names);
+    virtual ~Portfolio();
+
+    // Run all algorithms on a pool of nb_threads threads (0 for all hardware threads)
+    // LB is used as hint for centric algorithms and as lower bound for multi-bin ones
+    // Returns the best solution found, -1 if no algorithm found a solution
+    int run(int LB, int nb_threads = 0);
+
+    // Time limit given to each multi-bin algorithm, see BaseAlgo::setTimeLimit
+    void setTimeLimit(double time_limit_ms); // 0 or less for no limit (default)
+
+    const std::vector<PortfolioResult>& getResults() const; // In the order of the algorithm names
+    int getBestSolution() const;
+    const std::string& getBestAlgoName() const;
+    BaseAlgo* getBestAlgo() const; // Holds the allocation of the best solution, nullptr if none
+
+protected:
+    void runAlgo(int index, int LB, int UB);
+
+    const Instance& instance;
+    const std::vector<std::string> algo_names;
+    std::vector<PortfolioResult> results;
+    double time_limit_ms;
+
+    std::mutex best_mutex;
+    BaseAlgo* best_algo;
+    int best_index; // Ties are broken in favor of the first algorithm in the list
+};
+
+#endif // PORTFOLIO_HPP
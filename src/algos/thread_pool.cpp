@@ -0,0 +1,180 @@
+#include "thread_pool.hpp"
+
+// Pool and index of the worker running on the current thread
+static thread_local ThreadPool* current_pool = nullptr;
+static thread_local int current_worker = -1;
+
+ThreadPool::ThreadPool(int nb_threads, int max_queued):
+    next_queue(0),
+    max_queued(max_queued),
+    nb_queued(0),
+    nb_unfinished(0),
+    stopping(false)
+{
+    if (nb_threads <= 0)
+    {
+        nb_threads = defaultNbThreads();
+    }
+
+    queues.reserve(nb_threads);
+    for (int i = 0; i < nb_threads; ++i)
+    {
+        queues.emplace_back(new WorkerQueue());
+    }
+
+    workers.reserve(nb_threads);
+    for (int i = 0; i < nb_threads; ++i)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    task_available.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    all_done.wait(lock, [this]() { return nb_unfinished == 0; });
+}
+
+int ThreadPool::getNbThreads() const
+{
+    return workers.size();
+}
+
+int ThreadPool::getMaxQueued() const
+{
+    return max_queued;
+}
+
+int ThreadPool::defaultNbThreads()
+{
+    int n = std::thread::hardware_concurrency();
+    if (n <= 0)
+    {
+        n = 1; // The value is not computable on this system
+    }
+    return n;
+}
+
+bool ThreadPool::push(std::function<void()> task, bool wait_for_room)
+{
+    int queue_index;
+    if (current_pool == this)
+    {
+        // Keep the task local to the worker, other workers will steal it if idle
+        queue_index = current_worker;
+    }
+    else
+    {
+        queue_index = next_queue.fetch_add(1) % (int)queues.size();
+    }
+
+    // Counters are updated first, so that they never get below the actual number of tasks
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if ((max_queued > 0) && (current_pool != this))
+        {
+            auto has_room = [this]() { return nb_queued < max_queued; };
+            if (!wait_for_room && !has_room())
+            {
+                return false;
+            }
+            room_available.wait(lock, has_room);
+        }
+        nb_queued += 1;
+        nb_unfinished += 1;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[queue_index]->mutex);
+        queues[queue_index]->tasks.push_back(std::move(task));
+    }
+    task_available.notify_one();
+    return true;
+}
+
+bool ThreadPool::popTask(int worker_index, std::function<void()>& task)
+{
+    int nb_queues = queues.size();
+    for (int i = 0; i < nb_queues; ++i)
+    {
+        WorkerQueue& queue = *queues[(worker_index + i) % nb_queues];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            continue;
+        }
+
+        if (i == 0)
+        {
+            // Own queue: most recent task first, its data is likely still in cache
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            // Steal the oldest task of another worker
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(int worker_index)
+{
+    current_pool = this;
+    current_worker = worker_index;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            task_available.wait(lock, [this]() { return stopping || (nb_queued > 0); });
+            if (nb_queued == 0)
+            {
+                return; // Stopping and nothing left to do
+            }
+        }
+
+        std::function<void()> task;
+        if (!popTask(worker_index, task))
+        {
+            // Another worker took the task in the meantime,
+            // or the task is not yet in its queue
+            std::this_thread::yield();
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            nb_queued -= 1;
+        }
+        room_available.notify_one();
+
+        // Exceptions are caught by the packaged task and given back through the future
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            nb_unfinished -= 1;
+            if (nb_unfinished == 0)
+            {
+                all_done.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool of worker threads with work stealing
+// Each worker has its own queue of tasks:
+// - tasks submitted from outside the pool are distributed in round-robin
+// - tasks submitted from a worker go to the queue of that worker
+// A worker takes its most recent task first, and when its queue is empty
+// it steals the oldest task of another worker
+// With max_queued > 0, at most max_queued tasks wait in the queues: external
+// submissions block (or fail with trySubmit) until a worker takes a task.
+// Tasks submitted from a worker are never blocked, as this could deadlock the pool.
+class ThreadPool
+{
+public:
+    ThreadPool(int nb_threads = 0, int max_queued = 0); // 0 threads to use the number of hardware threads, 0 queued for no bound
+    virtual ~ThreadPool(); // Waits for all submitted tasks to complete
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Submit a task, its result (or exception) is available through the returned future
+    template <class F>
+    auto submit(F&& task) -> std::future<decltype(task())>
+    {
+        using R = decltype(task());
+        auto packaged = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+        std::future<R> result = packaged->get_future();
+        push([packaged]() { (*packaged)(); }, true);
+        return result;
+    }
+
+    // Same as submit, but returns false without waiting if the queues are full
+    template <class F, class R>
+    bool trySubmit(F&& task, std::future<R>& result)
+    {
+        auto packaged = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+        std::future<R> packaged_result = packaged->get_future();
+        if (!push([packaged]() { (*packaged)(); }, false))
+        {
+            return false;
+        }
+        result = std::move(packaged_result);
+        return true;
+    }
+
+    void wait(); // Block until all submitted tasks are completed, including tasks submitted meanwhile
+    int getNbThreads() const;
+    int getMaxQueued() const;
+
+    static int defaultNbThreads();
+
+protected:
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    bool push(std::function<void()> task, bool wait_for_room); // False if the queues are full and wait_for_room is false
+    bool popTask(int worker_index, std::function<void()>& task);
+    void workerLoop(int worker_index);
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkerQueue>> queues; // One queue per worker
+    std::atomic<int> next_queue; // For round-robin distribution of external tasks
+
+    std::mutex mutex; // Protects the counters below, for sleeping workers
+    std::condition_variable task_available;
+    std::condition_variable all_done;
+    std::condition_variable room_available; // For submissions blocked by max_queued
+    int max_queued;
+    int nb_queued;     // Number of tasks waiting in the queues
+    int nb_unfinished; // Number of tasks queued or being executed
+    bool stopping;
+};
+
+#endif // THREAD_POOL_HPP
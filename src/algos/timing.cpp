@@ -0,0 +1,179 @@
+#include "timing.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+void PhaseTimer::addTime(const std::string& phase, double time_ms)
+{
+    for (PhaseTiming& timing : phases)
+    {
+        if (timing.phase == phase)
+        {
+            timing.time_ms += time_ms;
+            timing.count += 1;
+            return;
+        }
+    }
+    phases.push_back({phase, time_ms, 1});
+}
+
+void PhaseTimer::merge(const PhaseTimer& other)
+{
+    for (const PhaseTiming& other_timing : other.phases)
+    {
+        auto it = std::find_if(phases.begin(), phases.end(),
+                               [&other_timing](const PhaseTiming& timing) { return timing.phase == other_timing.phase; });
+        if (it == phases.end())
+        {
+            phases.push_back(other_timing);
+        }
+        else
+        {
+            it->time_ms += other_timing.time_ms;
+            it->count += other_timing.count;
+        }
+    }
+}
+
+void PhaseTimer::clear()
+{
+    phases.clear();
+}
+
+const std::vector<PhaseTiming>& PhaseTimer::getPhases() const
+{
+    return phases;
+}
+
+double PhaseTimer::getPhaseTime(const std::string& phase) const
+{
+    for (const PhaseTiming& timing : phases)
+    {
+        if (timing.phase == phase)
+        {
+            return timing.time_ms;
+        }
+    }
+    return 0.0;
+}
+
+std::string PhaseTimer::toString() const
+{
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    for (const PhaseTiming& timing : phases)
+    {
+        ss << timing.phase << ": " << timing.time_ms << " ms";
+        if (timing.count > 1)
+        {
+            ss << " (" << timing.count << " runs)";
+        }
+        ss << "\n";
+    }
+    return ss.str();
+}
+
+std::string PhaseTimer::toJson() const
+{
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3) << "{";
+    for (int i = 0; i < (int)phases.size(); ++i)
+    {
+        if (i > 0)
+        {
+            ss << ", ";
+        }
+        ss << "\"" << phases[i].phase << "\": {\"time_ms\": " << phases[i].time_ms
+           << ", \"count\": " << phases[i].count << "}";
+    }
+    ss << "}";
+    return ss.str();
+}
+
+
+ScopedPhaseTimer::ScopedPhaseTimer(PhaseTimer& timer, const std::string& phase):
+    timer(timer),
+    phase(phase),
+    start(std::chrono::steady_clock::now())
+{ }
+
+ScopedPhaseTimer::~ScopedPhaseTimer()
+{
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    timer.addTime(phase, elapsed.count());
+}
+
+
+std::string formatTimingRuns(const std::vector<PhaseTimer>& runs, const bool json,
+                             const PhaseTimer& single_phases)
+{
+    // List of phases in their order of first occurrence across the runs
+    std::vector<std::string> phase_names;
+    for (const PhaseTimer& run : runs)
+    {
+        for (const PhaseTiming& timing : run.getPhases())
+        {
+            if (std::find(phase_names.begin(), phase_names.end(), timing.phase) == phase_names.end())
+            {
+                phase_names.push_back(timing.phase);
+            }
+        }
+    }
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    if (json)
+    {
+        ss << "{\"runs\": " << runs.size() << ", \"phases\": {";
+    }
+
+    for (int p = 0; p < (int)phase_names.size(); ++p)
+    {
+        std::vector<double> times;
+        times.reserve(runs.size());
+        for (const PhaseTimer& run : runs)
+        {
+            times.push_back(run.getPhaseTime(phase_names[p]));
+        }
+        std::sort(times.begin(), times.end());
+
+        double mean = 0.0;
+        for (double t : times)
+        {
+            mean += t;
+        }
+        mean /= times.size();
+
+        double median = times[times.size() / 2];
+        if (times.size() % 2 == 0)
+        {
+            median = (times[times.size() / 2 - 1] + median) / 2.0;
+        }
+
+        if (json)
+        {
+            if (p > 0)
+            {
+                ss << ", ";
+            }
+            ss << "\"" << phase_names[p] << "\": {\"min_ms\": " << times.front()
+               << ", \"median_ms\": " << median << ", \"mean_ms\": " << mean << "}";
+        }
+        else
+        {
+            ss << phase_names[p] << ": min " << times.front() << " ms, median "
+               << median << " ms, mean " << mean << " ms\n";
+        }
+    }
+
+    if (json)
+    {
+        ss << "}, \"single_phases\": " << single_phases.toJson() << "}\n";
+    }
+    else
+    {
+        ss << single_phases.toString();
+    }
+    return ss.str();
+}
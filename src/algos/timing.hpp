@@ -0,0 +1,57 @@
+#ifndef TIMING_HPP
+#define TIMING_HPP
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Accumulated wall-clock time of a named phase
+struct PhaseTiming
+{
+    std::string phase;
+    double time_ms; // Total time spent in the phase, in milliseconds
+    int count;      // Number of times the phase was run
+};
+
+// Records the time spent in the phases of a run (loading, lower bound, solving...)
+// Phases are kept in their order of first occurrence,
+// and the time of a phase run several times is accumulated
+class PhaseTimer
+{
+public:
+    void addTime(const std::string& phase, double time_ms);
+    void merge(const PhaseTimer& other); // Add all phases of other to this timer
+    void clear();
+
+    const std::vector<PhaseTiming>& getPhases() const;
+    double getPhaseTime(const std::string& phase) const; // 0 if the phase was never run
+
+    std::string toString() const;
+    std::string toJson() const;
+
+protected:
+    std::vector<PhaseTiming> phases;
+};
+
+// Measures the time spent in a scope with a steady clock, and adds it to a PhaseTimer
+class ScopedPhaseTimer
+{
+public:
+    ScopedPhaseTimer(PhaseTimer& timer, const std::string& phase);
+    ~ScopedPhaseTimer();
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    PhaseTimer& timer;
+    const std::string phase;
+    const std::chrono::steady_clock::time_point start;
+};
+
+// Summary of the timings of repeated runs: min, median and mean time of each phase
+// Phases of single_phases were run only once (e.g. writing the solution), and are reported as is
+std::string formatTimingRuns(const std::vector<PhaseTimer>& runs, const bool json = false,
+                             const PhaseTimer& single_phases = PhaseTimer());
+
+#endif // TIMING_HPP
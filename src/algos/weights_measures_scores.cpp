@@ -104,3 +104,21 @@ float utilComputeNorm2(const SizeList &list, const SizeList &normalization_list)
         return ((float)list[0] / normalization_list[0]);
     }
 }
+
+float utilComputeNorm2(const FloatList &norm_list)
+{
+    if (norm_list.size() > 1)
+    {
+        float val = 0.0;
+        for (float norm_val : norm_list)
+        {
+            val += norm_val * norm_val;
+        }
+        return std::sqrt(val);
+    }
+    else
+    {
+        // Only one dimension
+        return norm_list[0];
+    }
+}
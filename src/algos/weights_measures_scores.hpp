@@ -2,6 +2,8 @@
 #define ALGOS_WEIGHTS_MEASURES_SCORES
 
 #include "item.hpp"
+#include "bin.hpp"
+#include <algorithm>
 #include <map>
 
 #define ZERO_THRESHOLD 1e-5
@@ -87,4 +89,73 @@ float utilComputeNorm2(const SizeList &list);
 // normalization_list is the list to normalize each coefficient of list before computing the norm2
 float utilComputeNorm2(const SizeList &list, const SizeList &normalization_list);
 
+// Utility function to compute the Norm2 of values already normalized (e.g. the normalized bin capacities)
+float utilComputeNorm2(const FloatList &norm_list);
+
+// Combined size measure of an item, from its normalized sizes
+// The measure is a template parameter so that the loops calling it are compiled for one measure
+template<MEASURE M>
+inline float utilItemMeasure(const FloatList& weights, const FloatList& norm_sizes, int dimensions)
+{
+    float value = 0.0;
+    for (int h = 0; h < dimensions; ++h)
+    {
+        if constexpr (M == MEASURE::LINF)
+        {
+            value = std::max(value, weights[h] * norm_sizes[h]);
+        }
+        else if constexpr (M == MEASURE::L1)
+        {
+            value += weights[h] * norm_sizes[h];
+        }
+        else
+        {
+            // For L2 and L2_LOAD, the item measure is computed the same
+            // No need to compute the sqrt for ordering items
+            value += weights[h] * norm_sizes[h] * norm_sizes[h];
+        }
+    }
+    return value;
+}
+
+// Combined residual capacity measure of a bin
+// L2 reads the normalized residual capacities cached in the bin, the other measures keep
+// the order of operations of the division (weight * residual / capacity) and never compute the cache
+template<MEASURE M>
+inline float utilBinMeasure(const FloatList& weights, const Bin* bin, int dimensions)
+{
+    float value = 0.0;
+    if constexpr (M == MEASURE::L2)
+    {
+        const FloatList& norm_residuals = bin->getNormAvailableCaps();
+        for (int h = 0; h < dimensions; ++h)
+        {
+            float f = norm_residuals[h]; // Same as ((float)residuals[h]) / capacities[h]
+            value += weights[h] * f*f;
+        }
+        return value;
+    }
+
+    const SizeList& residuals = bin->getAvailableCaps();
+    const SizeList& capacities = bin->getMaxCaps();
+    for (int h = 0; h < dimensions; ++h)
+    {
+        if constexpr (M == MEASURE::LINF)
+        {
+            value = std::max(value, weights[h] * ((float)residuals[h]) / capacities[h]);
+        }
+        else if constexpr (M == MEASURE::L1)
+        {
+            value += weights[h] * ((float)residuals[h]) / capacities[h];
+        }
+        else // MEASURE::L2_LOAD
+        {
+            // Normalized value of used capacity (normalized load of the bin)
+            float f = ((float)(capacities[h] - residuals[h])) / capacities[h];
+            value += weights[h] * f*f;
+        }
+    }
+    return value;
+}
+
 #endif //ALGOS_WEIGHTS_MEASURES_SCORES
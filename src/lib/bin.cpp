@@ -1,5 +1,6 @@
 #include "bin.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -11,6 +12,8 @@ Bin::Bin(int id, const SizeList& max_capacity):
     dimensions(max_capacity.size()),
     max_capacities(max_capacity),
     available_capacities(SizeList(max_capacity)),
+    norm_available_capacities(FloatList(max_capacity.size(), 1.0)),
+    norm_up_to_date(true),
     measure(0.0)
 { }
 
@@ -39,6 +42,24 @@ const int Bin::getAvailableCapDim(const int dim) const
     return available_capacities.at(dim);
 }
 
+const FloatList& Bin::getNormAvailableCaps() const
+{
+    if (!norm_up_to_date)
+    {
+        for (int i = 0; i < dimensions; ++i)
+        {
+            norm_available_capacities[i] = ((float)available_capacities[i]) / max_capacities[i];
+        }
+        norm_up_to_date = true;
+    }
+    return norm_available_capacities;
+}
+
+const float Bin::getNormAvailableCapDim(const int dim) const
+{
+    return getNormAvailableCaps().at(dim);
+}
+
 
 const AllocList& Bin::getAllocList() const
 {
@@ -57,6 +78,39 @@ void Bin::addItem(Item* item)
     {
         available_capacities[i] -= item_sizes[i];
     }
+    norm_up_to_date = false;
+}
+
+bool Bin::removeItem(const Item* item)
+{
+    auto it = std::find(alloc_list.begin(), alloc_list.end(), item->getId());
+    if (it == alloc_list.end())
+    {
+        return false;
+    }
+    alloc_list.erase(it); // Keeps the order of the other items
+
+    const SizeList& item_sizes = item->getSizes();
+    for (int i = 0; i < dimensions; ++i)
+    {
+        available_capacities[i] += item_sizes[i];
+    }
+    norm_up_to_date = false;
+    return true;
+}
+
+// Restore the bin to its empty state
+// Capacity of the alloc list is kept so that the bin can be re-used without new allocation
+void Bin::reset()
+{
+    alloc_list.clear();
+    for (int i = 0; i < dimensions; ++i)
+    {
+        available_capacities[i] = max_capacities[i];
+        norm_available_capacities[i] = 1.0;
+    }
+    norm_up_to_date = true;
+    measure = 0.0;
 }
 
 bool Bin::doesItemFit(const SizeList& item_sizes) const
@@ -171,16 +225,17 @@ bool vectorpack::bin_comparator_capacity_dim_increasing(Bin* bina, Bin* binb, in
     return (bina->getAvailableCapDim(dim) < binb->getAvailableCapDim(dim));
 }
 
-// Perform one round of bubble upwards
-void vectorpack::bubble_bin_up(BinList::iterator first, BinList::iterator last, bool comp(Bin*, Bin*))
+// Perform one round of bubble upwards, returns the number of swaps
+int vectorpack::bubble_bin_up(BinList::iterator first, BinList::iterator last, bool comp(Bin*, Bin*))
 {
     if (first == last)
-        return; // Maybe first is also at the end
+        return 0; // Maybe first is also at the end
     --last; // last MUST point to the end of the vector
     // In case only one element
     if (first == last)
-        return;
+        return 0;
 
+    int nb_swaps = 0;
     auto current = last;
     auto previous = last-1;
     while(first != previous)
@@ -188,6 +243,7 @@ void vectorpack::bubble_bin_up(BinList::iterator first, BinList::iterator last,
         if (comp(*current, *previous))
         {
             std::iter_swap(current, previous);
+            nb_swaps++;
         }
         --current;
         --previous;
@@ -196,30 +252,35 @@ void vectorpack::bubble_bin_up(BinList::iterator first, BinList::iterator last,
     if (comp(*current, *previous))
     {
         std::iter_swap(current, previous);
+        nb_swaps++;
     }
+    return nb_swaps;
 }
 
 
 
-// Perform one round of bubble downwards
-void vectorpack::bubble_bin_down(BinList::iterator first, BinList::iterator last, bool comp(Bin*, Bin*))
+// Perform one round of bubble downwards, returns the number of swaps
+int vectorpack::bubble_bin_down(BinList::iterator first, BinList::iterator last, bool comp(Bin*, Bin*))
 {
     if (first == last)
-        return; // Empty list...
+        return 0; // Empty list...
 
     auto next = first;
     next++;
     if (next == last) // There is only one element in the list
-        return;
+        return 0;
 
+    int nb_swaps = 0;
     auto current = first;
     while(next != last)
     {
         if (comp(*next, *current))
         {
             std::iter_swap(current, next);
+            nb_swaps++;
         }
         ++current;
         ++next;
     }
+    return nb_swaps;
 }
@@ -25,11 +25,17 @@ public:
     const int getMaxCapDim(const int dim) const;
     const SizeList& getAvailableCaps() const;
     const int getAvailableCapDim(const int dim) const;
+    // Available / max capacity, in each dimension
+    // Computed on the first read after the bin changed: algorithms that never read it do not pay the divisions
+    const FloatList& getNormAvailableCaps() const;
+    const float getNormAvailableCapDim(const int dim) const;
 
     const AllocList& getAllocList() const;
 
     void addItem(Item* item);
+    bool removeItem(const Item* item); // Returns false if the item is not in the bin
     bool doesItemFit(const SizeList& sizes) const;
+    void reset(); // Empty the bin, keeping its allocated buffers
 
     const std::string formatAlloc(bool verbose = false) const;
     void printAlloc(bool verbose = false) const;
@@ -43,6 +49,8 @@ protected:
     const int dimensions;
     const SizeList& max_capacities;
     SizeList available_capacities;
+    mutable FloatList norm_available_capacities; // Cache of getNormAvailableCaps
+    mutable bool norm_up_to_date; // False when available_capacities changed since the cache was computed
 
     // Vector of item id allocated to this bin
     AllocList alloc_list;
@@ -57,8 +65,8 @@ bool bin_comparator_lexicographic_increasing(Bin* bina, Bin* binb);
 bool bin_comparator_lexicographic_decreasing(Bin* bina, Bin* binb);
 bool bin_comparator_capacity_dim_increasing(Bin* bina, Bin* binb, int dim);
 
-void bubble_bin_up(BinList::iterator first, BinList::iterator last, bool comp(Bin*, Bin*));
-void bubble_bin_down(BinList::iterator first, BinList::iterator last, bool comp(Bin*, Bin*));
+int bubble_bin_up(BinList::iterator first, BinList::iterator last, bool comp(Bin*, Bin*));
+int bubble_bin_down(BinList::iterator first, BinList::iterator last, bool comp(Bin*, Bin*));
 
 } // namespace vectorpack
 #endif // VECTORPACK_BIN_HPP
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <algorithm> // For std::shuffle
+#include <limits>
 #include <random> // For the random generator
 
 using namespace std;
@@ -46,6 +47,7 @@ Instance::Instance(const std::string instance_name,
 
         // Retrieve the item list
         item_list.reserve(this->nb_items);
+        initAggregates();
 
         // For each row create one Item
         for(int internal_id = 0; internal_id < this->nb_items; internal_id++)
@@ -61,6 +63,7 @@ Instance::Instance(const std::string instance_name,
                 throw runtime_error(err);
             }
 
+            addToAggregates(sizes);
             item_list.push_back(new Item(internal_id, sizes, norm_sizes));
         }
 
@@ -70,6 +73,7 @@ Instance::Instance(const std::string instance_name,
         {
             std::shuffle(item_list.begin(), item_list.end(), std::default_random_engine(RANDOM_SEED));
         }
+        finishAggregates();
     }
     catch (exception& e)
     {
@@ -78,6 +82,48 @@ Instance::Instance(const std::string instance_name,
     }
 }
 
+Instance::Instance(const std::string instance_name,
+                   const SizeList& capacities,
+                   const std::vector<SizeList>& item_sizes,
+                   const bool shuffle_items):
+    name(instance_name),
+    items_shuffled(shuffle_items),
+    nb_items(item_sizes.size()),
+    dimensions(capacities.size()),
+    capacity_list(capacities)
+{
+    item_list.reserve(nb_items);
+    initAggregates();
+    for (int internal_id = 0; internal_id < nb_items; internal_id++)
+    {
+        SizeList sizes = item_sizes[internal_id];
+        if (sizes.size() != (size_t)dimensions)
+        {
+            for (Item* item : item_list)
+            {
+                delete item;
+            }
+            std::string err("Size list of item " + to_string(internal_id) + " does not have the required dimension! Found " + to_string(sizes.size()) + " but given d=" + to_string(dimensions));
+            throw runtime_error(err);
+        }
+
+        FloatList norm_sizes;
+        norm_sizes.reserve(dimensions);
+        for (int h = 0; h < dimensions; ++h)
+        {
+            norm_sizes.push_back((float)sizes[h] / (float)capacity_list[h]);
+        }
+        addToAggregates(sizes);
+        item_list.push_back(new Item(internal_id, sizes, norm_sizes));
+    }
+
+    if (shuffle_items)
+    {
+        std::shuffle(item_list.begin(), item_list.end(), std::default_random_engine(RANDOM_SEED));
+    }
+    finishAggregates();
+}
+
 
 Instance::~Instance()
 {
@@ -120,6 +166,98 @@ const bool Instance::getItemsShuffled() const
     return items_shuffled;
 }
 
+const std::vector<int64_t>& Instance::getTotalSizes() const
+{
+    return total_sizes;
+}
+
+const FloatList& Instance::getTotalNormSizes() const
+{
+    return total_norm_sizes;
+}
+
+const SizeList& Instance::getMinSizes() const
+{
+    return min_sizes;
+}
+
+const SizeList& Instance::getMaxSizes() const
+{
+    return max_sizes;
+}
+
+const int Instance::getLowerBoundBPP() const
+{
+    return lower_bound_BPP;
+}
+
+void Instance::initAggregates()
+{
+    total_sizes.assign(dimensions, 0);
+    min_sizes.assign(dimensions, std::numeric_limits<int>::max());
+    max_sizes.assign(dimensions, 0);
+}
+
+void Instance::addToAggregates(const SizeList& sizes)
+{
+    for (int h = 0; h < dimensions; ++h)
+    {
+        total_sizes[h] += sizes[h];
+        min_sizes[h] = std::min(min_sizes[h], sizes[h]);
+        max_sizes[h] = std::max(max_sizes[h], sizes[h]);
+    }
+}
+
+void Instance::finishAggregates()
+{
+    if (nb_items == 0)
+    {
+        min_sizes.assign(dimensions, 0);
+    }
+
+    lower_bound_BPP = 0;
+    for (int h = 0; h < dimensions; ++h)
+    {
+        int64_t bins = (total_sizes[h] + capacity_list[h] - 1) / capacity_list[h];
+        lower_bound_BPP = std::max(lower_bound_BPP, (int)bins);
+    }
+
+    // Float sums depend on the order of the terms: the items are summed in their final order,
+    // which is the order of the copy of the item list made by the algorithms
+    total_norm_sizes.assign(dimensions, 0.0);
+    for (const Item* item : item_list)
+    {
+        for (int h = 0; h < dimensions; ++h)
+        {
+            total_norm_sizes[h] += item->getNormSizeDim(h);
+        }
+    }
+}
+
+bool Instance::getCachedItemOrder(const std::string& key, ItemList& items) const
+{
+    std::lock_guard<std::mutex> lock(item_orders_mutex);
+    auto it = item_orders.find(key);
+    if (it == item_orders.end())
+    {
+        return false;
+    }
+    items = it->second;
+    return true;
+}
+
+void Instance::setCachedItemOrder(const std::string& key, const ItemList& items) const
+{
+    std::lock_guard<std::mutex> lock(item_orders_mutex);
+    item_orders[key] = items;
+}
+
+void Instance::clearCachedItemOrders() const
+{
+    std::lock_guard<std::mutex> lock(item_orders_mutex);
+    item_orders.clear();
+}
+
 
 SizeList vectorpack::retrieveCapacityList(std::string resource_str)
 {
@@ -3,6 +3,10 @@
 
 #include "item.hpp"
 
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace vectorpack {
@@ -13,6 +17,13 @@ public:
              const std::string& filename,
              const bool shuffle_items = true);
 
+    // Build an instance from sizes already in memory (e.g. generated instances)
+    // item_sizes holds the size list of each item, in the order of their ids
+    Instance(const std::string instance_name,
+             const SizeList& capacities,
+             const std::vector<SizeList>& item_sizes,
+             const bool shuffle_items = true);
+
     virtual ~Instance();
 
     const std::string& getName() const;
@@ -21,6 +32,20 @@ public:
     const SizeList& getBinCapacities() const;
     const ItemList& getItems() const;
     const bool getItemsShuffled() const;
+
+    // Aggregates of the item sizes, computed once when the instance is built
+    const std::vector<int64_t>& getTotalSizes() const; // Sum of the sizes in each dimension
+    const FloatList& getTotalNormSizes() const; // Sum of the normalized sizes, in the order of getItems()
+    const SizeList& getMinSizes() const; // Smallest size in each dimension, 0 without items
+    const SizeList& getMaxSizes() const; // Largest size in each dimension, 0 without items
+    const int getLowerBoundBPP() const; // Maximum over the dimensions of ceil(total size / capacity)
+
+    // Cache of item orders shared by algorithms working on this instance
+    // The key describes the ordering parameters, and must only be used for orders
+    // that do not depend on the packing (i.e. static weights)
+    bool getCachedItemOrder(const std::string& key, ItemList& items) const;
+    void setCachedItemOrder(const std::string& key, const ItemList& items) const;
+    void clearCachedItemOrders() const;
 private:
     const std::string name;    // The instance name
     const bool items_shuffled; // Whether the items were shuffled
@@ -29,6 +54,19 @@ private:
 
     SizeList capacity_list;// The list of bin capacities
     ItemList item_list;   // The list of Items of this instance
+
+    std::vector<int64_t> total_sizes;
+    FloatList total_norm_sizes;
+    SizeList min_sizes;
+    SizeList max_sizes;
+    int lower_bound_BPP;
+
+    void initAggregates();
+    void addToAggregates(const SizeList& sizes); // While the items are built
+    void finishAggregates(); // Once the items are in their final order
+
+    mutable std::map<std::string, ItemList> item_orders; // Cached item orders
+    mutable std::mutex item_orders_mutex; // Algorithms may share the instance across threads
 };
 
 SizeList retrieveCapacityList(std::string resource_str);
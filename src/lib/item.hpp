@@ -24,24 +24,78 @@ public:
     const float getNormSizeDim(const int dim) const;
     std::string toString(const bool full = false) const;
 
-    void setMeasure(float measure);
-    const float getMeasure() const;
     const int getNbDimensions() const;
 
 protected:
-    int id;     // 0-based item id
+    // Items are read-only once the instance is loaded, so that they can be shared by algorithms
+    // Combined size measures are stored by the algorithms, indexed by item id
+    const int id;     // 0-based item id
     const SizeList sizes;// The list of size in each dimension
     const FloatList norm_sizes; // The list of normalized size in each dimension
-
-    float measure; // Placeholder for a combined size measure
 };
 
-bool item_comparator_measure_increasing(Item* itema, Item* itemb);
-bool item_comparator_measure_decreasing(Item* itema, Item* itemb);
 bool item_comparator_lexicographic_decreasing(Item* itema, Item* itemb);
 bool item_comparator_size_dim_increasing(Item* itema, Item* itemb, int dim);
-void bubble_items_down(ItemList::iterator first, ItemList::iterator last, bool comp (Item*, Item*));
-void bubble_items_up(ItemList::iterator first, ItemList::iterator last, bool comp (Item*, Item*));
+
+// Perform one round of bubble downwards, returns the number of swaps
+template <class Compare>
+int bubble_items_down(ItemList::iterator first, ItemList::iterator last, Compare comp)
+{
+    if (first == last) // The vector is empty...
+        return 0;
+
+    auto next = first;
+    next++;
+    if (next == last) // there is only one element in the vector
+        return 0;
+
+    int nb_swaps = 0;
+    auto current = first;
+    while(next != last)
+    {
+        if (comp(*next, *current))
+        {
+            std::iter_swap(current, next);
+            nb_swaps++;
+        }
+        ++current;
+        ++next;
+    }
+    return nb_swaps;
+}
+
+// Perform one round of bubble upwards, returns the number of swaps
+template <class Compare>
+int bubble_items_up(ItemList::iterator first, ItemList::iterator last, Compare comp)
+{
+    if (first == last)
+        return 0; // Maybe first is also at the end
+    --last; // last MUST point to the end of the vector
+    // In case only one element
+    if (first == last)
+        return 0;
+
+    int nb_swaps = 0;
+    auto current = last;
+    auto previous = last-1;
+    while(first != previous)
+    {
+        if (comp(*current, *previous))
+        {
+            std::iter_swap(current, previous);
+            nb_swaps++;
+        }
+        --current;
+        --previous;
+    }
+    // One last time at the head of the vector
+    if (comp(*current, *previous))
+    {
+        std::iter_swap(current, previous);
+        nb_swaps++;
+    }
+    return nb_swaps;
+}
 
 } // namespace vectorpack
 #endif // VECTORPACK_ITEM_HPP
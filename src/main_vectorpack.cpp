@@ -1,15 +1,20 @@
 #include <algo_utils.hpp>
+#include <portfolio.hpp>
+#include <batch.hpp>
+#include <online_simulation.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <fstream>
+#include <memory>
 #include <vector>
 #include <string>
-//#include <chrono> // TODO running time disabled for now
+#include <sstream>
 #include <stdexcept>
 
 using namespace std;
 using namespace vectorpack;
-//using namespace std::chrono;
 
 /*
  * Simple program to solve a Vector Bin Packing instance
@@ -17,17 +22,26 @@ using namespace vectorpack;
  * Inputs:
  *  - the instance file (.vbp format)
  *  - the name of the packing algorithm to run (or a lower bound)
+ *    or a comma-separated list of algorithms in portfolio mode
  * Output:
  *  - prints the solution (number of bins)
  * Options:
  *  - to write the solution allocation in a file
+ *
+ * In batch mode, a manifest lists the instances and the algorithms to run on them
+ * and the results of all pairs are written in CSV or JSONL format
+ *
+ * In simulation mode, an online packer replays a trace of item arrivals and departures
+ * and the number of bins in use over time is written in CSV format
  */
 
 void show_usage(std::string prog_name)
 {
-    // TODO need to add an option to show a list of possible algorithms
-
     std::cerr << "Usages: " << prog_name << " <instance_file.vbp> <algorithm_name> [<options>]\n"
+              << "        " << prog_name << " --batch <manifest_file> [<batch_options>]\n"
+              << "        " << prog_name << " --simulate <trace_file> <online_packer_name> [<simulation_options>]\n"
+              << "        " << prog_name << " --list-algorithms [patterns]\n"
+              << "\tLists all valid algorithm names on stdout, or the pattern of each family of algorithms with 'patterns'\n"
               << "Options:\n"
               << "\t-o <filename>, --output <filename>: Writes the solution and allocation into <filename>. Disables usual output to stdout.\n"
               << "\t\tThe first line of the output contains the number of bins in the solution.\n"
@@ -36,11 +50,252 @@ void show_usage(std::string prog_name)
               << "\t--order-bins-output: Outputs bins in their order of creation\n"
               << "\t--offset-item-ids: Makes item identifiers start at 1 instead of 0 in the output\n"
               << "\t--no-shuffle: Disables shuffling of items during loading of the instance\n"
+              << "\t--portfolio: <algorithm_name> is a comma-separated list of algorithms run concurrently on the instance.\n"
+              << "\t\t'all' selects every algorithm, and a name ending with '*' the algorithms starting with it (e.g. 'BCS-*')\n"
+              << "\t\tThe result of each algorithm is reported on stderr, and the best solution is output\n"
+              << "\t-j <n>, --threads <n>: Number of threads used in portfolio mode and by the clique lower bounds (default: number of hardware threads)\n"
+              << "\t--timing: Reports on stderr the time spent in each phase (loading, lower bound, upper bound, solving, writing)\n"
+              << "\t--timing-json: Same as --timing, in JSON format\n"
+              << "\t--repeat <n>: Runs the loading and solving phases <n> times and reports min, median and mean times (default: 1)\n"
+              << "\t--warmup <n>: Runs the loading and solving phases <n> times before the measured runs (default: 0)\n"
+              << "\t--time-limit <ms>: Time limit of multi-bin algorithms (of each one in portfolio mode), the best solution found in time is output (default: none)\n"
+              << "\t--lb <name>: Lower bound given to the algorithms, where multi-bin algorithms start their search (default: LB_BPP)\n"
+              << "\t\tOne of LB_BPP, LB_L2, LB_DFF, LB_clique, LB_clique_implicit, LB_max, which are also valid <algorithm_name>\n"
+              << "\t--stats: Reports on stderr the operation counters of the algorithm, in JSON with --timing-json (requires a build with -Denable_counters=ON)\n"
+              << "Batch options:\n"
+              << "\tEach line of the manifest contains an instance file followed by the names of the algorithms to run on it\n"
+              << "\t('all' and names ending with '*' are expanded as in portfolio mode)\n"
+              << "\t-o <filename>, --output <filename>: Writes the results into <filename> instead of stdout\n"
+              << "\t--format <csv|jsonl>: Format of the results (default: csv)\n"
+              << "\t-j <n>, --threads <n>: Number of threads (default: number of hardware threads)\n"
+              << "\t--no-shuffle: Disables shuffling of items during loading of the instances\n"
+              << "\t--lb <name>: Lower bound computed for each instance and given to the algorithms (default: LB_BPP)\n"
+              << "\t--time-limit <ms>: Time limit of each multi-bin algorithm, the best solution found in time is reported (default: none)\n"
+              << "Simulation options:\n"
+              << "\tThe online packer is FF, BF-<measure>-<weight> or WF-<measure>-<weight>\n"
+              << "\tThe trace starts with the number of dimensions and the bin capacities, then one event per line:\n"
+              << "\t'<time> A <item_id> <sizes>' for an arrival, '<time> D <item_id>' for a departure\n"
+              << "\t-o <filename>, --output <filename>: Writes the bins in use over time into <filename> instead of stdout\n"
+              << "\t--sample <instance_file.vbp>: Instance used to compute the weights of the packer (required for weights other than Unit)\n"
               << std::endl;
 }
 
+int run_batch(int argc, char** argv)
+{
+    string manifest_file(argv[2]);
+    string output_file;
+    BATCH_FORMAT format = BATCH_FORMAT::CSV;
+    int nb_threads = 0;
+    bool shuffle_items = true;
+    string lb_name = "LB_BPP";
+    double time_limit_ms = 0.0;
+
+    for (int i = 3; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if ((arg == "-o") || (arg == "--output") || (arg == "--format") || (arg == "-j") || (arg == "--threads")
+            || (arg == "--lb") || (arg == "--time-limit"))
+        {
+            if (i+1 >= argc)
+            {
+                std::cerr << "Value missing for option '" << arg << "'" << std::endl;
+                return 1;
+            }
+            std::string value = argv[++i];
+            if ((arg == "-o") || (arg == "--output"))
+            {
+                output_file = value;
+            }
+            else if (arg == "--format")
+            {
+                auto it = map_str_to_batch_format.find(value);
+                if (it == map_str_to_batch_format.end())
+                {
+                    std::cerr << "Unknown batch format: " << value << std::endl;
+                    return 1;
+                }
+                format = it->second;
+            }
+            else if (arg == "--lb")
+            {
+                if (!isLowerBound(value))
+                {
+                    std::cerr << "Unknown lower bound: " << value << std::endl;
+                    return 1;
+                }
+                lb_name = value;
+            }
+            else if (arg == "--time-limit")
+            {
+                time_limit_ms = std::stod(value);
+            }
+            else
+            {
+                nb_threads = std::stoi(value);
+            }
+        }
+        else if (arg == "--no-shuffle")
+        {
+            shuffle_items = false;
+        }
+        else
+        {
+            std::cerr << "Unknow option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<BatchJob> jobs = readBatchManifest(manifest_file);
+
+    int nb_failed;
+    if (output_file.empty())
+    {
+        BatchRunner runner(jobs, std::cout, format, shuffle_items, lb_name, time_limit_ms);
+        nb_failed = runner.run(nb_threads);
+    }
+    else
+    {
+        std::ofstream f(output_file, std::ios_base::trunc);
+        if (!f.is_open())
+        {
+            std::string s("Cannot write batch results to file " + output_file);
+            throw std::runtime_error(s);
+        }
+        BatchRunner runner(jobs, f, format, shuffle_items, lb_name, time_limit_ms);
+        nb_failed = runner.run(nb_threads);
+    }
+
+    if (nb_failed > 0)
+    {
+        std::cerr << nb_failed << " algorithm runs failed" << std::endl;
+    }
+    return 0;
+}
+
+int run_simulation(int argc, char** argv)
+{
+    string trace_file(argv[2]);
+    string packer_name(argv[3]);
+    string output_file;
+    string sample_file;
+
+    for (int i = 4; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if ((arg == "-o") || (arg == "--output") || (arg == "--sample"))
+        {
+            if (i+1 >= argc)
+            {
+                std::cerr << "Value missing for option '" << arg << "'" << std::endl;
+                return 1;
+            }
+            std::string value = argv[++i];
+            if (arg == "--sample")
+            {
+                sample_file = value;
+            }
+            else
+            {
+                output_file = value;
+            }
+        }
+        else
+        {
+            std::cerr << "Unknow option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    Trace trace = readTrace(trace_file);
+
+    std::unique_ptr<Instance> sample;
+    if (!sample_file.empty())
+    {
+        string sample_name = sample_file.substr(sample_file.find_last_of("/\\") + 1);
+        sample.reset(new Instance(sample_name, sample_file, false));
+    }
+    std::unique_ptr<OnlinePacker> packer(createOnlinePacker(packer_name, trace.capacities, sample.get()));
+
+    SimulationSummary summary;
+    if (output_file.empty())
+    {
+        summary = simulateTrace(trace, *packer, &std::cout);
+    }
+    else
+    {
+        std::ofstream f(output_file, std::ios_base::trunc);
+        if (!f.is_open())
+        {
+            std::string s("Cannot write simulation results to file " + output_file);
+            throw std::runtime_error(s);
+        }
+        summary = simulateTrace(trace, *packer, &f);
+    }
+
+    double events_per_s = (summary.replay_ms > 0.0) ? summary.nb_events / summary.replay_ms * 1000.0 : 0.0;
+    std::cerr << "Simulation of " << packer_name << ": " << summary.nb_events << " events ("
+              << summary.nb_arrivals << " arrivals, " << summary.nb_departures << " departures), "
+              << "peak " << summary.peak_bins << " bins, final " << packer->getNbBins() << " bins, "
+              << "replay " << summary.replay_ms << " ms (" << (long)events_per_s << " events/s)" << std::endl;
+    return 0;
+}
+
+int list_algorithms(int argc, char** argv)
+{
+    if (argc == 2)
+    {
+        for (const std::string& name : listAlgoNames())
+        {
+            std::cout << name << "\n";
+        }
+    }
+    else if ((argc == 3) && (std::string(argv[2]) == "patterns"))
+    {
+        for (const AlgoFamily& family : getAlgoFamilies())
+        {
+            std::cout << family.getPattern() << "\n";
+        }
+        std::cout << "<measure>: ";
+        for (const auto& measure : map_str_to_measure)
+        {
+            std::cout << measure.first << " ";
+        }
+        std::cout << "\n<weight>, <bin_weight>: ";
+        for (const auto& weight : map_str_to_weight)
+        {
+            std::cout << weight.first << " ";
+        }
+        std::cout << "\n<score>: ";
+        for (const auto& score : map_str_to_score)
+        {
+            std::cout << score.first << " ";
+        }
+        std::cout << "\n<n>: a positive number of bins\n";
+    }
+    else
+    {
+        show_usage(argv[0]);
+        return 1;
+    }
+    std::cout << std::flush;
+    return 0;
+}
+
 int main(int argc, char** argv)
 {
+    if ((argc >= 2) && (std::string(argv[1]) == "--list-algorithms"))
+    {
+        return list_algorithms(argc, argv);
+    }
+    if ((argc >= 3) && (std::string(argv[1]) == "--batch"))
+    {
+        return run_batch(argc, argv);
+    }
+    if ((argc >= 4) && (std::string(argv[1]) == "--simulate"))
+    {
+        return run_simulation(argc, argv);
+    }
+
     if (argc < 3)
     {
         show_usage(argv[0]);
@@ -56,6 +311,15 @@ int main(int argc, char** argv)
     bool order_bins_output = false;
     bool offset_item_ids = false;
     bool shuffle_items = true;
+    bool portfolio_mode = false;
+    int nb_threads = 0;
+    bool timing = false;
+    bool timing_json = false;
+    int nb_repeat = 1;
+    int nb_warmup = 0;
+    bool print_stats = false;
+    double time_limit_ms = 0.0;
+    string lb_name = "LB_BPP";
 
     // Parsing options from CLI greatly inspired by
     // https://cplusplus.com/articles/DEN36Up4/
@@ -93,6 +357,74 @@ int main(int argc, char** argv)
         {
             shuffle_items = false;
         }
+        else if (arg == "--portfolio")
+        {
+            portfolio_mode = true;
+        }
+        else if ((arg == "-j") || (arg == "--threads") || (arg == "--repeat") || (arg == "--warmup"))
+        {
+            if (i+1 < argc)
+            {
+                int value = std::stoi(argv[i+1]);
+                ++i;
+                if ((arg == "-j") || (arg == "--threads"))
+                {
+                    nb_threads = value;
+                }
+                else if (arg == "--repeat")
+                {
+                    nb_repeat = std::max(value, 1);
+                }
+                else
+                {
+                    nb_warmup = std::max(value, 0);
+                }
+            }
+            else
+            {
+                std::cerr << "Number missing for option '" << arg << "'" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--timing")
+        {
+            timing = true;
+        }
+        else if (arg == "--timing-json")
+        {
+            timing = true;
+            timing_json = true;
+        }
+        else if (arg == "--stats")
+        {
+            print_stats = true;
+        }
+        else if (arg == "--time-limit")
+        {
+            if (i+1 < argc)
+            {
+                time_limit_ms = std::stod(argv[i+1]);
+                ++i;
+            }
+            else
+            {
+                std::cerr << "Number missing for option '" << arg << "'" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--lb")
+        {
+            if ((i+1 < argc) && isLowerBound(argv[i+1]))
+            {
+                lb_name = argv[i+1];
+                ++i;
+            }
+            else
+            {
+                std::cerr << "Lower bound name missing or unknown for option '--lb'" << std::endl;
+                return 1;
+            }
+        }
         else
         {
             std::cerr << "Unknow option: " << arg << std::endl;
@@ -101,69 +433,142 @@ int main(int argc, char** argv)
     }
     // End of parsing options
 
-    Instance inst(instance_name, instance_file, shuffle_items);
-
-    //time_point<high_resolution_clock> start;
-    //time_point<high_resolution_clock> stop;
+    std::vector<std::string> algo_names; // For portfolio mode
+    if (portfolio_mode)
+    {
+        std::istringstream names_stream(algo_name);
+        std::string name;
+        while (std::getline(names_stream, name, ','))
+        {
+            if (!name.empty())
+            {
+                algo_names.push_back(name);
+            }
+        }
+        try
+        {
+            algo_names = expandAlgoNames(algo_names);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
 
-    // First check if lower bound is asked
+    Instance * inst = nullptr;
     bool only_LB = false;
-    int sol;
-    BaseAlgo * algo;
+    int sol = -1;
+    BaseAlgo * algo = nullptr;
+    Portfolio * portfolio = nullptr;
 
-    if (algo_name == "LB_clique")
-    {
-        only_LB = true;
-        //start = high_resolution_clock::now();
-        sol = LB_clique(inst);
-        //stop = high_resolution_clock::now();
-    }
-    else if (algo_name == "LB_BPP")
-    {
-        only_LB = true;
-        //start = high_resolution_clock::now();
-        sol = LB_BPP(inst);
-        //stop = high_resolution_clock::now();
-    }
-    else // This is an algorithm
+    // The timings of the measured runs, warmup runs are discarded
+    std::vector<PhaseTimer> runs_timings;
+    PhaseTimer timer;
+
+    for (int run = 0; run < nb_warmup + nb_repeat; ++run)
     {
-        int LB = LB_BPP(inst);
-        string type_algo = algo_name.substr(0, 4);
+        // Only the objects of the last run are kept for the output
+        if (portfolio != nullptr)
+        {
+            delete portfolio; // Also deletes the best algorithm
+        }
+        else if (algo != nullptr)
+        {
+            delete algo;
+        }
+        portfolio = nullptr;
+        algo = nullptr;
+        if (inst != nullptr)
+        {
+            delete inst;
+        }
+        timer.clear();
 
-        bool is_multibin = false; // Whether it is a multi-bin type algorithm
-        if (type_algo == "BIM-")
         {
-            algo = createAlgoPairing(algo_name, inst);
-            is_multibin = true;
+            ScopedPhaseTimer phase_timer(timer, "load");
+            inst = new Instance(instance_name, instance_file, shuffle_items);
         }
-        else if ( (type_algo == "WFDm") || (type_algo == "BFDm"))
+
+        // First check if lower bound is asked
+        if (isLowerBound(algo_name))
         {
-            algo = createAlgoWFDm(algo_name, inst);
-            is_multibin = true;
+            only_LB = true;
+            ScopedPhaseTimer phase_timer(timer, "LB");
+            sol = computeLowerBound(algo_name, *inst, nb_threads);
         }
         else
         {
-            algo = createAlgoCentric(algo_name, inst);
+            int LB;
+            {
+                ScopedPhaseTimer phase_timer(timer, "LB");
+                LB = computeLowerBound(lb_name, *inst, nb_threads);
+            }
+
+            if (portfolio_mode)
+            {
+                portfolio = new Portfolio(*inst, algo_names);
+                portfolio->setTimeLimit(time_limit_ms);
+                {
+                    ScopedPhaseTimer phase_timer(timer, "portfolio");
+                    sol = portfolio->run(LB, nb_threads);
+                }
+
+                algo = portfolio->getBestAlgo();
+                // If no algorithm found a solution, only the number is output
+                only_LB = (algo == nullptr);
+            }
+            else // This is an algorithm
+            {
+                algo = createAlgo(algo_name, *inst);
+                algo->setTimeLimit(time_limit_ms);
+
+                int UB = 0;
+                if (isMultiBinAlgo(algo_name))
+                {
+                    ScopedPhaseTimer phase_timer(timer, "UB_FF");
+                    UB = computeUpperBoundFF(*inst, LB);
+                }
+
+                {
+                    ScopedPhaseTimer phase_timer(timer, "solve");
+                    sol = solveWithAlgo(algo, algo_name, LB, UB);
+                }
+
+                // Phases measured inside the algorithm
+                timer.merge(algo->getTimings());
+            }
         }
 
-        if (is_multibin)
+        if (run >= nb_warmup)
         {
-            BaseAlgo * algoFF = createAlgoCentric("FF", inst);
-            int UB = algoFF->solveInstance(LB);
-            delete algoFF;
+            runs_timings.push_back(timer);
+        }
+    }
 
-            //start = high_resolution_clock::now();
-            sol = algo->solveInstanceMultiBin(LB, UB);
-            //stop = high_resolution_clock::now();
+    if (portfolio != nullptr)
+    {
+        for (const PortfolioResult& result : portfolio->getResults())
+        {
+            std::cerr << result.algo_name << ": " << result.solution;
+            if (!result.error.empty())
+            {
+                std::cerr << " (" << result.error << ")";
+            }
+            std::cerr << "\n";
         }
-        else
+        if (algo != nullptr)
         {
-            //start = high_resolution_clock::now();
-            sol = algo->solveInstance(LB);
-            //stop = high_resolution_clock::now();
+            std::cerr << "Best: " << portfolio->getBestAlgoName() << std::endl;
         }
     }
 
+    if ((algo != nullptr) && !algo->isConverged())
+    {
+        std::cerr << "Time limit reached, the solution may not be the best the algorithm can find" << std::endl;
+    }
+
+    std::chrono::steady_clock::time_point write_start = std::chrono::steady_clock::now();
     if (write_alloc)
     {
         // Write the algorithm solution in a file
@@ -214,10 +619,47 @@ int main(int argc, char** argv)
 
     }
 
-    if (!only_LB)
+    cout.flush();
+    std::chrono::duration<double, std::milli> write_time = std::chrono::steady_clock::now() - write_start;
+    timer.addTime("write", write_time.count());
+
+    if (timing)
+    {
+        if (nb_repeat == 1)
+        {
+            // Single run, the write phase is part of it
+            std::cerr << (timing_json ? timer.toJson() + "\n" : timer.toString());
+        }
+        else
+        {
+            PhaseTimer write_timer;
+            write_timer.addTime("write", write_time.count());
+            std::cerr << formatTimingRuns(runs_timings, timing_json, write_timer);
+        }
+    }
+
+    if (print_stats)
+    {
+        if (!AlgoStats::isEnabled())
+        {
+            std::cerr << "Operation counters are not available, build with -Denable_counters=ON\n";
+        }
+        else if (algo != nullptr)
+        {
+            // Counters of the last run (of the best algorithm in portfolio mode)
+            std::cerr << (timing_json ? algo->getStats().toJson() + "\n" : algo->getStats().toString());
+        }
+    }
+
+    if (portfolio != nullptr)
+    {
+        delete portfolio; // Also deletes the best algorithm
+    }
+    else if (algo != nullptr)
     {
         delete algo;
     }
+    delete inst;
 
     return 0;
 }
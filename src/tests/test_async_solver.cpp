@@ -0,0 +1,153 @@
+#include "test_utils.hpp"
+
+#include <instance_generator.hpp>
+#include <async_solver.hpp>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace vectorpack;
+
+/*
+ * Checks of AsyncSolver:
+ *  - the result of a job: bounds, solution and allocation of all items
+ *  - a job cancelled while it waits in the queue, or while it runs, throws SolveCancelled
+ *    through its future, soon after the cancellation even during the First Fit upper bound
+ *  - trySubmit fails while max_queued jobs are waiting
+ *  - the errors of a job (e.g. unknown algorithm name) are thrown by its future
+ */
+
+// Multi-bin search long enough to be cancelled while it runs: the First Fit upper bound alone takes seconds
+static const std::string LONG_ALGO = "WFDm-BS-L2-Avg";
+
+static std::shared_ptr<const Instance> makeInstance(int nb_items, int dimensions)
+{
+    GeneratorParams params = {"CT1", nb_items, dimensions, 1000, 1, 1};
+    return std::shared_ptr<const Instance>(generateInstance(params, false));
+}
+
+// Whether the future throws SolveCancelled, and not another error
+static bool throwsCancelled(std::future<SolveResult>& result)
+{
+    try {
+        result.get();
+    }
+    catch (SolveCancelled&)
+    {
+        return true;
+    }
+    catch (std::exception&)
+    { }
+    return false;
+}
+
+static void testSolveResult()
+{
+    std::shared_ptr<const Instance> instance = makeInstance(200, 2);
+    AsyncSolver solver(2);
+    SolveJob multi_bin = solver.submit(instance, "WFDm-BS-L2-Avg");
+    SolveJob centric = solver.submit(instance, "FFD-L2-Avg");
+
+    SolveResult result = multi_bin.result.get();
+    CHECK(result.algo_name == "WFDm-BS-L2-Avg");
+    CHECK(result.LB > 0);
+    CHECK(result.UB >= result.solution);
+    CHECK(result.solution >= result.LB);
+    CHECK(result.converged);
+    CHECK((int)result.allocations.size() == result.solution);
+
+    result = centric.result.get();
+    CHECK(result.UB == -1);
+    CHECK(result.solution >= result.LB);
+    std::set<int> item_ids;
+    for (const AllocList& allocation : result.allocations)
+    {
+        item_ids.insert(allocation.begin(), allocation.end());
+    }
+    CHECK((int)item_ids.size() == instance->getNbItems());
+}
+
+static void testCancelQueued()
+{
+    std::shared_ptr<const Instance> instance = makeInstance(20000, 5);
+    AsyncSolver solver(1);
+    SolveJob running = solver.submit(instance, LONG_ALGO);
+    SolveJob queued = solver.submit(instance, "FFD-L2-Avg"); // Waits for the only thread
+
+    queued.cancel();
+    running.cancel();
+    CHECK(throwsCancelled(running.result));
+    CHECK(throwsCancelled(queued.result));
+}
+
+static void testCancelRunning()
+{
+    std::shared_ptr<const Instance> instance = makeInstance(20000, 5);
+    AsyncSolver solver(1);
+    SolveJob job = solver.submit(instance, LONG_ALGO);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    auto cancel_time = std::chrono::steady_clock::now();
+    job.cancel();
+    CHECK(throwsCancelled(job.result));
+    double cancel_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cancel_time).count();
+    CHECK(cancel_ms < 1000.0, std::to_string(cancel_ms) + " ms");
+}
+
+static void testMaxQueued()
+{
+    std::shared_ptr<const Instance> instance = makeInstance(20000, 5);
+    AsyncSolver solver(1, 1);
+    SolveJob running = solver.submit(instance, LONG_ALGO);
+    SolveJob queued = solver.submit(instance, LONG_ALGO); // Returns once the first job started
+
+    SolveJob rejected;
+    CHECK(!solver.trySubmit(instance, "FFD-L2-Avg", SolveOptions(), rejected));
+
+    queued.cancel();
+    running.cancel();
+    solver.wait();
+    CHECK(throwsCancelled(running.result));
+    CHECK(throwsCancelled(queued.result));
+
+    SolveJob accepted;
+    CHECK(solver.trySubmit(makeInstance(200, 2), "FFD-L2-Avg", SolveOptions(), accepted));
+    CHECK(accepted.result.get().solution > 0);
+}
+
+static void testErrors()
+{
+    std::shared_ptr<const Instance> instance = makeInstance(200, 2);
+    AsyncSolver solver(1);
+    SolveJob unknown = solver.submit(instance, "FFD-unknown");
+    bool thrown = false;
+    try {
+        unknown.result.get();
+    }
+    catch (SolveCancelled&)
+    { }
+    catch (std::runtime_error&)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    // The solver goes on with the next jobs
+    SolveJob job = solver.submit(instance, "FFD-L2-Avg");
+    CHECK(job.result.get().solution > 0);
+}
+
+int main()
+{
+    testSolveResult();
+    testCancelQueued();
+    testCancelRunning();
+    testMaxQueued();
+    testErrors();
+    return testResult("test_async_solver");
+}
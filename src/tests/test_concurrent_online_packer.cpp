@@ -0,0 +1,178 @@
+#include "test_utils.hpp"
+
+#include <concurrent_online_packer.hpp>
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace vectorpack;
+
+/*
+ * Checks of ConcurrentOnlinePacker:
+ *  - single thread: the placement is First Fit
+ *  - several threads placing and releasing items: the residual capacities never get below 0
+ *    (checked by a thread reading them meanwhile), the items held in each bin add up to its
+ *    used capacity, and all residual capacities are back to the capacities when all items left
+ */
+
+static const SizeList CAPACITIES = {100, 80, 60};
+
+static void testFirstFit()
+{
+    ConcurrentOnlinePacker packer(CAPACITIES, 8);
+    CHECK(packer.place({60, 10, 10}) == 0);
+    CHECK(packer.place({60, 10, 10}) == 1); // Does not fit in bin 0 in the first dimension
+    CHECK(packer.place({40, 70, 50}) == 0);
+    CHECK(packer.place({10, 10, 10}) == 1); // Bin 0 is full in the second dimension
+    CHECK(packer.getNbBins() == 2);
+    CHECK(packer.getAvailableCaps(0) == SizeList({0, 0, 0}));
+    CHECK(packer.getAvailableCaps(1) == SizeList({30, 60, 40}));
+
+    // A release makes room again in the first bin
+    packer.release(0, {40, 70, 50});
+    CHECK(packer.place({30, 60, 40}) == 0);
+
+    CHECK_THROWS(packer.place({101, 0, 0})); // Larger than the bins
+    CHECK_THROWS(packer.place({1, 1}));      // Wrong number of dimensions
+    CHECK_THROWS(packer.release(5, {1, 1, 1})); // Bin not opened
+}
+
+static void testMaxBins()
+{
+    ConcurrentOnlinePacker packer(CAPACITIES, 2);
+    packer.place({100, 1, 1});
+    packer.place({100, 1, 1});
+    CHECK_THROWS(packer.place({100, 1, 1}));
+    CHECK(packer.getNbBins() == 2);
+}
+
+static void testConcurrentPlaceRelease()
+{
+    const int nb_threads = 8;
+    const int nb_steps = 20000;   // Per thread
+    const int max_held = 64;      // Items held by a thread at the same time
+    const int max_bins = 2 * nb_threads * max_held; // Room for the bins skipped under contention
+    ConcurrentOnlinePacker packer(CAPACITIES, max_bins);
+
+    // Reads all residual capacities while the other threads place and release items
+    std::atomic<bool> stop_monitor(false);
+    std::atomic<long> nb_out_of_range(0);
+    std::thread monitor([&]() {
+        while (!stop_monitor.load())
+        {
+            for (int bin_id = 0; bin_id < packer.getNbBins(); ++bin_id)
+            {
+                SizeList residuals = packer.getAvailableCaps(bin_id);
+                for (size_t h = 0; h < CAPACITIES.size(); ++h)
+                {
+                    if ((residuals[h] < 0) || (residuals[h] > CAPACITIES[h]))
+                    {
+                        nb_out_of_range++;
+                    }
+                }
+            }
+        }
+    });
+
+    // Items still held by each thread after its loop, as (bin id, sizes)
+    std::vector<std::vector<std::pair<int, SizeList>>> held(nb_threads);
+    std::atomic<long> nb_errors(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nb_threads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            std::mt19937 random(1000 + t);
+            std::vector<std::pair<int, SizeList>>& items = held[t];
+            for (int step = 0; step < nb_steps; ++step)
+            {
+                if (!items.empty() && ((items.size() == (size_t)max_held) || (random() % 2 == 0)))
+                {
+                    size_t index = random() % items.size();
+                    packer.release(items[index].first, items[index].second);
+                    items[index] = items.back();
+                    items.pop_back();
+                }
+                else
+                {
+                    SizeList sizes(CAPACITIES.size());
+                    for (size_t h = 0; h < CAPACITIES.size(); ++h)
+                    {
+                        sizes[h] = 1 + random() % (CAPACITIES[h] / 2);
+                    }
+                    try {
+                        items.emplace_back(packer.place(sizes), sizes);
+                    }
+                    catch (std::exception&)
+                    {
+                        nb_errors++; // Far fewer items are held than max_bins, some bin always has room
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Each bin has exactly the capacity used by the items still held
+    std::vector<SizeList> used(packer.getNbBins(), SizeList(CAPACITIES.size(), 0));
+    for (const auto& items : held)
+    {
+        for (const auto& item : items)
+        {
+            for (size_t h = 0; h < CAPACITIES.size(); ++h)
+            {
+                used[item.first][h] += item.second[h];
+            }
+        }
+    }
+    for (int bin_id = 0; bin_id < packer.getNbBins(); ++bin_id)
+    {
+        SizeList residuals = packer.getAvailableCaps(bin_id);
+        for (size_t h = 0; h < CAPACITIES.size(); ++h)
+        {
+            CHECK(residuals[h] + used[bin_id][h] == CAPACITIES[h], "bin " + std::to_string(bin_id));
+        }
+    }
+
+    // Release everything from all threads at the same time
+    threads.clear();
+    for (int t = 0; t < nb_threads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for (const auto& item : held[t])
+            {
+                packer.release(item.first, item.second);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    stop_monitor = true;
+    monitor.join();
+
+    CHECK(nb_errors.load() == 0);
+    CHECK(nb_out_of_range.load() == 0);
+    CHECK(packer.getNbBins() <= max_bins);
+    for (int bin_id = 0; bin_id < packer.getNbBins(); ++bin_id)
+    {
+        CHECK(packer.getAvailableCaps(bin_id) == CAPACITIES, "bin " + std::to_string(bin_id));
+    }
+
+    // The bounds of the blocks are still valid: items fill the first bins again
+    CHECK(packer.place({100, 80, 60}) == 0);
+}
+
+int main()
+{
+    testFirstFit();
+    testMaxBins();
+    testConcurrentPlaceRelease();
+    return testResult("test_concurrent_online_packer");
+}
@@ -0,0 +1,236 @@
+#include "test_utils.hpp"
+
+#include <instance_generator.hpp>
+#include <algo_registry.hpp>
+#include <algo_utils.hpp>
+#include <algos_OneDim.hpp>
+#include <algos_TwoDim.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace vectorpack;
+
+/*
+ * Checks of the engines of the item-centric algorithms for one-dimensional and two-dimensional instances:
+ *  - FirstFitTree and DominanceIndex against a scan of all bins
+ *  - the algorithms created by the registry against the same algorithms created without
+ *    engine (AlgoFit::solveInstance), which must give the same list of bins with the same items
+ */
+
+static void testFirstFitTree()
+{
+    const int max_bins = 100; // Not a power of 2
+    FirstFitTree tree(max_bins);
+    AlgoStats stats;
+    std::vector<int> residuals; // Of the bins created so far
+    std::mt19937 random(7);
+    int nb_mismatches = 0;
+    for (int step = 0; step < 20000; ++step)
+    {
+        int size = random() % 101;
+        int expected = -1;
+        for (int bin_index = 0; (bin_index < (int)residuals.size()) && (expected < 0); ++bin_index)
+        {
+            expected = (residuals[bin_index] >= size) ? bin_index : -1;
+        }
+        nb_mismatches += (tree.findFirst(size, stats) != expected);
+
+        // Create a bin, or change the residual capacity of a bin
+        int bin_index = random() % max_bins;
+        if (bin_index >= (int)residuals.size())
+        {
+            bin_index = residuals.size();
+            residuals.push_back(0);
+        }
+        residuals[bin_index] = random() % 101;
+        tree.setResidual(bin_index, residuals[bin_index]);
+    }
+    CHECK(nb_mismatches == 0);
+    CHECK((stats.index_nodes > 0) || !AlgoStats::isEnabled());
+}
+
+static void testDominanceIndex()
+{
+    const int max_points = 50;
+    const int max_value = 30;
+    std::mt19937 random(11);
+    SizeList x_thresholds;
+    SizeList y_thresholds;
+    for (int i = 0; i < 40; ++i) // With duplicates
+    {
+        x_thresholds.push_back(random() % (max_value + 1));
+        y_thresholds.push_back(random() % (max_value + 1));
+    }
+    DominanceIndex index(x_thresholds, y_thresholds, max_points);
+    AlgoStats stats;
+
+    // Points in the index, (x, y) and key, with unique keys
+    std::vector<bool> inserted(max_points, false);
+    std::vector<std::pair<int, int>> coordinates(max_points);
+    std::vector<DominanceIndex::Key> keys(max_points);
+    int nb_mismatches = 0;
+    for (int step = 0; step < 20000; ++step)
+    {
+        int a = x_thresholds[random() % x_thresholds.size()];
+        int b = y_thresholds[random() % y_thresholds.size()];
+        int expected = -1;
+        for (int point = 0; point < max_points; ++point)
+        {
+            if (inserted[point] && (coordinates[point].first >= a) && (coordinates[point].second >= b)
+                && ((expected < 0) || (keys[point] < keys[expected])))
+            {
+                expected = point;
+            }
+        }
+        nb_mismatches += (index.findMin(a, b, stats) != expected);
+
+        // Insert, move or erase a point
+        int point = random() % max_points;
+        if (inserted[point])
+        {
+            index.erase(point);
+            inserted[point] = false;
+        }
+        if (random() % 4 != 0)
+        {
+            coordinates[point] = std::make_pair(random() % (max_value + 1), random() % (max_value + 1));
+            keys[point] = DominanceIndex::Key((float)(random() % 10), step); // Ties on the measure
+            index.insert(point, coordinates[point].first, coordinates[point].second, keys[point]);
+            inserted[point] = true;
+        }
+    }
+    CHECK(nb_mismatches == 0);
+    CHECK((stats.index_nodes > 0) || !AlgoStats::isEnabled());
+}
+
+// Creators of the algorithms without engine, by pattern of their family (with static weights)
+using GeneralCreator = std::function<BaseAlgo*(const std::string& algo_name, const AlgoSpec& spec, const Instance& instance)>;
+static const std::map<std::string, GeneralCreator> general_creators = {
+    {"FF", [](const std::string& n, const AlgoSpec&, const Instance& i) { return new AlgoFF(n, i); }},
+    {"FFD-<measure>-<weight>[-Dyn]", [](const std::string& n, const AlgoSpec& s, const Instance& i) {
+        return new AlgoFFD(n, i, s.measure, s.weight, false); }},
+    {"BFD-T1-<measure>-<weight>[-Dyn]", [](const std::string& n, const AlgoSpec& s, const Instance& i) {
+        return new AlgoBFD_T1(n, i, s.measure, s.weight, false); }},
+    {"BFD-T2-<measure>-<weight>[-Dyn]", [](const std::string& n, const AlgoSpec& s, const Instance& i) {
+        return new AlgoBFD_T2(n, i, s.measure, s.weight, false); }},
+    {"BFD-T3-<measure>-<weight>-<bin_weight>[-Dyn]", [](const std::string& n, const AlgoSpec& s, const Instance& i) {
+        return new AlgoBFD_T3(n, i, s.measure, s.weight, s.bin_weight, false); }},
+    {"BF-<measure>-<weight>", [](const std::string& n, const AlgoSpec& s, const Instance& i) {
+        return new AlgoBF(n, i, s.measure, s.weight); }},
+    {"WFD-T1-<measure>-<weight>[-Dyn]", [](const std::string& n, const AlgoSpec& s, const Instance& i) {
+        return new AlgoWFD_T1(n, i, s.measure, s.weight, false); }},
+    {"WFD-T2-<measure>-<weight>[-Dyn]", [](const std::string& n, const AlgoSpec& s, const Instance& i) {
+        return new AlgoWFD_T2(n, i, s.measure, s.weight, false); }},
+    {"WFD-T3-<measure>-<weight>-<bin_weight>[-Dyn]", [](const std::string& n, const AlgoSpec& s, const Instance& i) {
+        return new AlgoWFD_T3(n, i, s.measure, s.weight, s.bin_weight, false); }},
+    {"WF-<measure>-<weight>", [](const std::string& n, const AlgoSpec& s, const Instance& i) {
+        return new AlgoWF(n, i, s.measure, s.weight); }},
+};
+
+// Item ids of each bin, in the order of the list of bins
+static std::vector<AllocList> binContents(const BaseAlgo* algo)
+{
+    std::vector<AllocList> contents;
+    for (const Bin* bin : algo->getBins())
+    {
+        contents.push_back(bin->getAllocList());
+    }
+    return contents;
+}
+
+// Returns the number of algorithms compared
+static int checkSameSolutions(const Instance& instance, const std::string& context)
+{
+    int nb_compared = 0;
+    for (const std::string& algo_name : listAlgoNames())
+    {
+        AlgoSpec spec;
+        const AlgoFamily* family = findAlgoFamily(algo_name, spec);
+        auto creator_it = general_creators.find(family->getPattern());
+        if ((creator_it == general_creators.end()) || spec.dynamic || (spec.weight == WEIGHT::UTILIZATION_RATIO))
+        {
+            continue; // Dynamic weights have no dedicated engine
+        }
+
+        std::unique_ptr<BaseAlgo> engine(createAlgo(algo_name, instance));
+        std::unique_ptr<BaseAlgo> general(creator_it->second(algo_name, spec, instance));
+        int engine_solution = engine->solveInstance();
+        int general_solution = general->solveInstance();
+        CHECK(engine_solution == general_solution, algo_name + " on " + context);
+        CHECK(binContents(engine.get()) == binContents(general.get()), algo_name + " on " + context);
+        nb_compared++;
+    }
+    return nb_compared;
+}
+
+static void testOneDimEngines()
+{
+    uint64_t seed = 1;
+    for (const auto& generator_class : map_str_to_generator_class)
+    {
+        GeneratorParams params = {generator_class.first, 200, 1, 1000, seed++, 3};
+        std::unique_ptr<Instance> instance(generateInstance(params, false));
+        CHECK(checkSameSolutions(*instance, generatedInstanceName(params)) > 0);
+    }
+
+    // Many items of the same size (ties in the lists of bins), and empty items
+    std::mt19937 random(3);
+    std::vector<SizeList> item_sizes;
+    for (int i = 0; i < 300; ++i)
+    {
+        item_sizes.push_back({(int)(random() % 11)});
+    }
+    Instance ties("ties", {10}, item_sizes, false);
+    checkSameSolutions(ties, "ties");
+
+    // Bins too large for the measures to order them exactly (the engines fall back on the general one)
+    for (SizeList& sizes : item_sizes)
+    {
+        sizes[0] = sizes[0] * (1 << 20) + 1;
+    }
+    Instance large("large", {(10 << 20) + 10}, item_sizes, false);
+    checkSameSolutions(large, "large");
+}
+
+static void testTwoDimEngines()
+{
+    uint64_t seed = 1;
+    for (const auto& generator_class : map_str_to_generator_class)
+    {
+        GeneratorParams params = {generator_class.first, 200, 2, 1000, seed++, 3};
+        std::unique_ptr<Instance> instance(generateInstance(params, false));
+        CHECK(checkSameSolutions(*instance, generatedInstanceName(params)) > 0);
+    }
+
+    // Many items of the same sizes (ties in the lists of bins), and empty items
+    std::mt19937 random(5);
+    std::vector<SizeList> item_sizes;
+    for (int i = 0; i < 300; ++i)
+    {
+        item_sizes.push_back({(int)(random() % 6), (int)(random() % 6)});
+    }
+    Instance ties("ties", {10, 10}, item_sizes, false);
+    checkSameSolutions(ties, "ties");
+
+    // Nothing in the second dimension: some weights are not finite (the engine falls back on the general one)
+    for (SizeList& sizes : item_sizes)
+    {
+        sizes[1] = 0;
+    }
+    Instance flat("flat", {10, 10}, item_sizes, false);
+    checkSameSolutions(flat, "flat");
+}
+
+int main()
+{
+    testFirstFitTree();
+    testDominanceIndex();
+    testOneDimEngines();
+    testTwoDimEngines();
+    return testResult("test_fit_engines");
+}
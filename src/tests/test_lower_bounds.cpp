@@ -0,0 +1,196 @@
+#include "test_utils.hpp"
+
+#include <instance_generator.hpp>
+#include <lower_bounds.hpp>
+#include <algo_utils.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace vectorpack;
+
+/*
+ * Checks of the lower bounds:
+ *  - on small instances where their value is known
+ *  - on generated instances, where they are at most the solution of First Fit
+ *  - LB_clique against the original greedy on a vector<vector<bool>> matrix, which must give the same clique size
+ */
+
+static const int CAPACITY = 1000;
+
+static std::unique_ptr<Instance> makeInstance(const SizeList& capacities, const std::vector<SizeList>& item_sizes)
+{
+    return std::unique_ptr<Instance>(new Instance("test", capacities, item_sizes, false));
+}
+
+static void testKnownBounds()
+{
+    // Three items larger than half the capacity: LB_BPP only counts their total size
+    std::unique_ptr<Instance> halves = makeInstance({10}, {{6}, {6}, {6}});
+    CHECK(LB_BPP(*halves) == 2);
+    CHECK(LB_L2(*halves) == 3);
+    CHECK(LB_DFF(*halves) == 3);
+    CHECK(LB_max(*halves) == 3);
+
+    // No item is larger than half the capacity, the total size in the first dimension is the bound
+    std::unique_ptr<Instance> mixed = makeInstance({10, 10}, {{5, 0}, {5, 0}, {5, 0}, {4, 3}, {4, 3}, {0, 3}});
+    CHECK(LB_BPP(*mixed) == 3);
+    CHECK(LB_L2(*mixed) == 3);
+    CHECK(LB_DFF(*mixed) <= 3);
+
+    for (const std::string& name : lower_bound_names)
+    {
+        CHECK(computeLowerBound(name, *halves) == ((name == "LB_BPP") ? 2 : 3), name);
+    }
+    CHECK_THROWS(computeLowerBound("LB_unknown", *halves));
+}
+
+static void testKnownCliques()
+{
+    // All items are larger than half the capacity in the first dimension: one bin each
+    std::unique_ptr<Instance> large = makeInstance({10, 10}, {{6, 1}, {7, 2}, {6, 9}, {9, 0}, {8, 5}});
+    CHECK(LB_clique_implicit(*large) == 5);
+    CHECK(LB_clique_implicit(*large, 0) == 5); // Without the graph
+
+    // Items fitting pairwise
+    std::unique_ptr<Instance> small = makeInstance({10, 10}, {{5, 1}, {4, 5}, {2, 2}, {5, 5}});
+    CHECK(LB_clique_implicit(*small) == 1);
+    CHECK(LB_clique_implicit(*small, 0) == 1);
+
+    // Large items in different dimensions, with a small item incompatible with all of them
+    std::unique_ptr<Instance> mixed = makeInstance({10, 10}, {{6, 1}, {5, 6}, {5, 5}, {1, 1}});
+    CHECK(LB_clique_implicit(*mixed) == 3);
+    CHECK(LB_clique_implicit(*mixed, 0) == 3);
+}
+
+static void testGeneratedInstances()
+{
+    uint64_t seed = 1;
+    for (const auto& generator_class : map_str_to_generator_class)
+    {
+        for (int dimensions : {1, 2, 5})
+        {
+            GeneratorParams params = {generator_class.first, 200, dimensions, CAPACITY, seed++, 3};
+            std::unique_ptr<Instance> instance(generateInstance(params, false));
+            const std::string context = generatedInstanceName(params);
+            const int FF = computeUpperBoundFF(*instance);
+
+            const int LB_bpp = LB_BPP(*instance);
+            const int LB_l2 = LB_L2(*instance);
+            const int LB_dff = LB_DFF(*instance);
+            CHECK(LB_bpp <= LB_l2, context); // L2 with K = 0
+            CHECK(LB_l2 <= FF, context);
+            CHECK(LB_dff <= FF, context);
+            const int LB_all = LB_max(*instance, 4);
+            CHECK(LB_all == std::max({LB_bpp, LB_l2, LB_dff, LB_clique_implicit(*instance)}), context);
+            CHECK(LB_all <= FF, context);
+
+            const int LB_graph = LB_clique_implicit(*instance);
+            CHECK(LB_graph <= FF, context);
+            CHECK(LB_clique_implicit(*instance, LB_CLIQUE_MAX_GRAPH_ITEMS, 4) == LB_graph, context);
+            CHECK(LB_clique_implicit(*instance, 0) <= FF, context);
+            CHECK(LB_clique(*instance, 4) <= FF, context);
+        }
+    }
+}
+
+// Johnson's greedy of the original LB_clique: the item of highest degree (lowest index on ties) joins the
+// clique, then the items not adjacent to it are removed and the degrees of their neighbours decreased
+static int referenceClique(const Instance& instance)
+{
+    const ItemList& items = instance.getItems();
+    const SizeList& capacities = instance.getBinCapacities();
+    int nb_items = items.size();
+    std::vector<std::vector<bool>> adj(nb_items, std::vector<bool>(nb_items, false));
+    std::vector<int> degrees(nb_items, 0);
+    for (int i = 0; i < nb_items; ++i)
+    {
+        for (int j = i+1; j < nb_items; ++j)
+        {
+            if (check_incompatibility(items[i], items[j], capacities))
+            {
+                adj[i][j] = true;
+                adj[j][i] = true;
+                degrees[i]++;
+                degrees[j]++;
+            }
+        }
+    }
+
+    std::vector<int> rest_list(nb_items);
+    for (int i = 0; i < nb_items; ++i)
+    {
+        rest_list[i] = i;
+    }
+    int clique_size = 0;
+    while (!rest_list.empty())
+    {
+        int y = argmax_degree(degrees);
+        if (y == -1)
+        {
+            return -1;
+        }
+        clique_size++;
+
+        std::vector<int> to_remove; // y is non adjacent to itself, it is removed as well
+        for (int item : rest_list)
+        {
+            if (!adj[y][item])
+            {
+                to_remove.push_back(item);
+            }
+        }
+        for (int item : to_remove)
+        {
+            rest_list.erase(std::find(rest_list.begin(), rest_list.end(), item));
+            for (int j = 0; j < nb_items; ++j)
+            {
+                if (adj[item][j])
+                {
+                    degrees[j]--;
+                }
+            }
+            degrees[item] = -1;
+        }
+    }
+    return clique_size;
+}
+
+static void testCliqueReference()
+{
+    uint64_t seed = 100;
+    for (const auto& generator_class : map_str_to_generator_class)
+    {
+        for (int dimensions : {1, 2, 5})
+        {
+            for (int nb_items : {50, 300})
+            {
+                GeneratorParams params = {generator_class.first, nb_items, dimensions, CAPACITY, seed++, 3};
+                std::unique_ptr<Instance> instance(generateInstance(params, true));
+                const std::string context = generatedInstanceName(params);
+                const int expected = referenceClique(*instance);
+                for (int nb_threads : {1, 2, 3, 8})
+                {
+                    CHECK(LB_clique(*instance, nb_threads) == expected, context + ", " + std::to_string(nb_threads) + " threads");
+                }
+            }
+        }
+    }
+
+    // Equal degrees, where picking the highest index instead of the lowest one gives a clique of 2
+    std::unique_ptr<Instance> ties = makeInstance({10, 10}, {{2, 4}, {4, 1}, {0, 8}, {2, 4}, {1, 8}, {9, 0}});
+    CHECK(referenceClique(*ties) == 3);
+    CHECK(LB_clique(*ties, 1) == 3, "ties");
+    CHECK(LB_clique(*ties, 4) == 3, "ties");
+}
+
+int main()
+{
+    testKnownBounds();
+    testKnownCliques();
+    testGeneratedInstances();
+    testCliqueReference();
+    return testResult("test_lower_bounds");
+}
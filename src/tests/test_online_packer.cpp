@@ -0,0 +1,168 @@
+#include "test_utils.hpp"
+
+#include <online_packer.hpp>
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace vectorpack;
+
+/*
+ * Checks of OnlinePacker with item departures:
+ *  - a released bin id is re-used by the next opened bin, the lowest one first
+ *  - random sequences of arrivals and departures, where each placement is compared with a
+ *    scan of all bins in use (First Fit: lowest id, Best and Worst Fit: lowest and highest
+ *    measure, ties broken by lowest id), and the residual capacities with the items in the bins
+ */
+
+static const SizeList CAPACITIES = {100, 80, 60};
+
+static void testSlotReuse()
+{
+    OnlinePacker packer(CAPACITIES, ONLINE_POLICY::FIRST_FIT);
+    for (int item_id = 0; item_id < 4; ++item_id)
+    {
+        CHECK(packer.place(item_id, {60, 50, 40}) == item_id); // One bin per item
+    }
+    CHECK(packer.getNbBins() == 4);
+
+    CHECK(packer.remove(2) == 2);
+    CHECK(packer.remove(1) == 1);
+    CHECK(packer.getNbBins() == 2);
+    CHECK(packer.getNbItems() == 2);
+    CHECK(packer.getBins()[1]->getAllocList().empty());
+
+    // The lowest released id first, then the other one, then a new bin
+    CHECK(packer.place(10, {60, 50, 40}) == 1);
+    CHECK(packer.place(11, {60, 50, 40}) == 2);
+    CHECK(packer.place(12, {60, 50, 40}) == 4);
+    CHECK(packer.getNbBins() == 5);
+    CHECK(packer.getBins().size() == 5);
+
+    // A small item goes in the first bin with room, a released bin is not used
+    CHECK(packer.remove(0) == 0);
+    CHECK(packer.place(13, {30, 20, 10}) == 1);
+
+    CHECK_THROWS(packer.place(13, {1, 1, 1}));   // Already placed
+    CHECK_THROWS(packer.place(14, {1, 1}));      // Wrong number of dimensions
+    CHECK_THROWS(packer.place(15, {101, 1, 1})); // Larger than the bins
+    CHECK_THROWS(packer.remove(0));              // Already removed
+    CHECK(packer.getNbItems() == 5);
+}
+
+// Bin expected for the item: the best bin in use where it fits, or the lowest released id, or a new bin
+static int expectedBin(const OnlinePacker& packer, ONLINE_POLICY policy, const std::set<int>& used_bins,
+                       const SizeList& sizes)
+{
+    int best_bin = -1;
+    for (int bin_id : used_bins) // Increasing ids
+    {
+        const Bin* bin = packer.getBins()[bin_id];
+        if (!bin->doesItemFit(sizes))
+        {
+            continue;
+        }
+        if ((best_bin < 0)
+            || ((policy == ONLINE_POLICY::BEST_FIT) && (bin->getMeasure() < packer.getBins()[best_bin]->getMeasure()))
+            || ((policy == ONLINE_POLICY::WORST_FIT) && (bin->getMeasure() > packer.getBins()[best_bin]->getMeasure())))
+        {
+            best_bin = bin_id;
+        }
+    }
+    if (best_bin >= 0)
+    {
+        return best_bin;
+    }
+    for (int bin_id = 0; bin_id < (int)packer.getBins().size(); ++bin_id)
+    {
+        if (used_bins.count(bin_id) == 0)
+        {
+            return bin_id;
+        }
+    }
+    return packer.getBins().size();
+}
+
+static void testRandomArrivalsDepartures(ONLINE_POLICY policy, MEASURE measure, unsigned seed)
+{
+    const std::string context = "policy " + std::to_string((int)policy) + ", measure " + std::to_string((int)measure);
+    OnlinePacker packer(CAPACITIES, policy, measure);
+    std::mt19937 random(seed);
+
+    std::vector<SizeList> item_sizes;
+    std::vector<int> item_bins; // -1 when not placed
+    std::set<int> used_bins;
+    std::vector<int> placed_items;
+    int nb_mismatches = 0;
+    for (int step = 0; step < 5000; ++step)
+    {
+        // Around 300 items in the bins, with steps where most items leave
+        bool departure = !placed_items.empty()
+            && ((placed_items.size() > 300) || (random() % 3 == 0) || ((step / 500) % 4 == 3));
+        if (departure)
+        {
+            size_t index = random() % placed_items.size();
+            int item_id = placed_items[index];
+            placed_items[index] = placed_items.back();
+            placed_items.pop_back();
+
+            int bin_id = packer.remove(item_id);
+            nb_mismatches += (bin_id != item_bins[item_id]);
+            if (packer.getBins()[bin_id]->getAllocList().empty())
+            {
+                used_bins.erase(bin_id);
+            }
+            item_bins[item_id] = -1;
+        }
+        else
+        {
+            SizeList sizes(CAPACITIES.size());
+            for (size_t h = 0; h < CAPACITIES.size(); ++h)
+            {
+                sizes[h] = random() % (CAPACITIES[h] / 2 + 1);
+            }
+            int item_id = item_sizes.size();
+            int expected_bin = expectedBin(packer, policy, used_bins, sizes);
+            int bin_id = packer.place(item_id, sizes);
+            nb_mismatches += (bin_id != expected_bin);
+
+            item_sizes.push_back(sizes);
+            item_bins.push_back(bin_id);
+            used_bins.insert(bin_id);
+            placed_items.push_back(item_id);
+        }
+    }
+    CHECK(nb_mismatches == 0, context);
+    CHECK(packer.getNbBins() == (int)used_bins.size(), context);
+    CHECK(packer.getNbItems() == (int)placed_items.size(), context);
+
+    // The residual capacities of the bins are those of their items
+    std::vector<SizeList> residuals(packer.getBins().size(), CAPACITIES);
+    for (int item_id : placed_items)
+    {
+        for (size_t h = 0; h < CAPACITIES.size(); ++h)
+        {
+            residuals[item_bins[item_id]][h] -= item_sizes[item_id][h];
+        }
+    }
+    for (const Bin* bin : packer.getBins())
+    {
+        CHECK(bin->getAvailableCaps() == residuals[bin->getId()], context + ", bin " + std::to_string(bin->getId()));
+    }
+}
+
+int main()
+{
+    testSlotReuse();
+    unsigned seed = 1;
+    for (ONLINE_POLICY policy : {ONLINE_POLICY::FIRST_FIT, ONLINE_POLICY::BEST_FIT, ONLINE_POLICY::WORST_FIT})
+    {
+        for (MEASURE measure : {MEASURE::LINF, MEASURE::L1, MEASURE::L2, MEASURE::L2_LOAD})
+        {
+            testRandomArrivalsDepartures(policy, measure, seed++);
+        }
+    }
+    return testResult("test_online_packer");
+}
@@ -0,0 +1,110 @@
+#include "test_utils.hpp"
+
+#include <thread_pool.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/*
+ * Checks of ThreadPool:
+ *  - results and exceptions of the tasks through their futures
+ *  - tasks submitted from a worker go to its own queue, and are stolen by the idle workers
+ *  - wait also waits for the tasks submitted meanwhile
+ *  - trySubmit fails when max_queued tasks are waiting
+ */
+
+static void testResults()
+{
+    ThreadPool pool(4);
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 1000; ++i)
+    {
+        results.push_back(pool.submit([i]() { return i * i; }));
+    }
+    long sum = 0;
+    for (std::future<int>& result : results)
+    {
+        sum += result.get();
+    }
+    CHECK(sum == 332833500L); // Sum of the squares below 1000
+
+    std::future<int> failed = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+    CHECK_THROWS(failed.get());
+}
+
+static void testStealing()
+{
+    const int nb_threads = 4;
+    const int nb_subtasks = 64;
+    ThreadPool pool(nb_threads);
+    std::mutex mutex;
+    std::set<std::thread::id> subtask_threads;
+    std::atomic<int> nb_done(0);
+
+    // All subtasks are in the queue of the worker running the first task, which then stays busy
+    pool.submit([&]() {
+        for (int i = 0; i < nb_subtasks; ++i)
+        {
+            pool.submit([&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    subtask_threads.insert(std::this_thread::get_id());
+                }
+                nb_done++;
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+    pool.wait();
+
+    CHECK(nb_done.load() == nb_subtasks);
+    CHECK(subtask_threads.size() > 1); // The other workers stole subtasks
+}
+
+static void testMaxQueued()
+{
+    ThreadPool pool(1, 2);
+    CHECK(pool.getNbThreads() == 1);
+    CHECK(pool.getMaxQueued() == 2);
+
+    // The only worker is blocked until the gate opens
+    std::promise<void> gate;
+    std::shared_future<void> gate_future = gate.get_future().share();
+    std::atomic<bool> started(false);
+    pool.submit([&]() {
+        started = true;
+        gate_future.wait();
+    });
+    while (!started.load())
+    {
+        std::this_thread::yield();
+    }
+
+    std::atomic<int> nb_done(0);
+    std::future<void> first, second, third;
+    CHECK(pool.trySubmit([&]() { nb_done++; }, first));
+    CHECK(pool.trySubmit([&]() { nb_done++; }, second));
+    CHECK(!pool.trySubmit([&]() { nb_done++; }, third)); // Two tasks are already waiting
+
+    gate.set_value();
+    pool.wait();
+    CHECK(nb_done.load() == 2);
+    CHECK(pool.trySubmit([&]() { nb_done++; }, third));
+    pool.wait();
+    CHECK(nb_done.load() == 3);
+}
+
+int main()
+{
+    testResults();
+    testStealing();
+    testMaxQueued();
+    return testResult("test_thread_pool");
+}
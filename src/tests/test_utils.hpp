@@ -0,0 +1,50 @@
+#ifndef TEST_UTILS_HPP
+#define TEST_UTILS_HPP
+
+#include <iostream>
+#include <string>
+
+/*
+ * Checks of the tests run by ctest, each test is an executable
+ * A failed check is reported on stderr and the test goes on, the test fails if any check failed
+ */
+
+static int test_failures = 0;
+
+static inline bool checkCondition(bool condition, const char* expression, const char* file, int line,
+                                  const std::string& context = "")
+{
+    if (!condition)
+    {
+        test_failures++;
+        std::cerr << file << ":" << line << ": check failed: " << expression
+                  << (context.empty() ? "" : " (" + context + ")") << "\n";
+    }
+    return condition;
+}
+
+// Check a condition, with an optional string describing the case
+#define CHECK(condition, ...) checkCondition((condition), #condition, __FILE__, __LINE__, ##__VA_ARGS__)
+
+// Check that a statement throws a std::exception
+#define CHECK_THROWS(statement) \
+    do { \
+        bool thrown = false; \
+        try { statement; } \
+        catch (std::exception&) { thrown = true; } \
+        checkCondition(thrown, #statement " throws", __FILE__, __LINE__); \
+    } while (false)
+
+// Exit code of the test
+static inline int testResult(const std::string& test_name)
+{
+    if (test_failures > 0)
+    {
+        std::cerr << test_name << ": " << test_failures << " failed checks\n";
+        return 1;
+    }
+    std::cout << test_name << ": all checks passed\n";
+    return 0;
+}
+
+#endif // TEST_UTILS_HPP
@@ -0,0 +1,189 @@
+#include "instance_generator.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+GeneratorRandom::GeneratorRandom(uint64_t seed):
+    state(seed)
+{ }
+
+uint64_t GeneratorRandom::next()
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+int GeneratorRandom::uniformInt(int min, int max)
+{
+    if (max <= min)
+    {
+        return min;
+    }
+    // The modulo bias is negligible with 64-bit values
+    uint64_t range = (uint64_t)((int64_t)max - min) + 1;
+    return (int)(min + (int64_t)(next() % range));
+}
+
+
+// Fraction num/den of the capacity, at least 1
+static int fractionOf(int capacity, int num, int den)
+{
+    return std::max(1, (int)((int64_t)capacity * num / den));
+}
+
+// Sizes of one item of a Caprara-Toth type (1 to 4)
+static void generateTypeSizes(int type, int capacity, GeneratorRandom& random, SizeList& sizes)
+{
+    int half = fractionOf(capacity, 1, 2);
+    int two_thirds = fractionOf(capacity, 2, 3);
+    for (int h = 0; h < (int)sizes.size(); ++h)
+    {
+        bool even_dim = (h % 2 == 0);
+        switch (type)
+        {
+        case 1:
+            sizes[h] = even_dim ? random.uniformInt(two_thirds, capacity) : random.uniformInt(1, half);
+            break;
+        case 2:
+            sizes[h] = even_dim ? random.uniformInt(1, half) : random.uniformInt(two_thirds, capacity);
+            break;
+        case 3:
+            sizes[h] = random.uniformInt(half, capacity);
+            break;
+        default:
+            sizes[h] = random.uniformInt(1, half);
+        }
+    }
+}
+
+// Sizes of one distinct item of the given class
+static void generateDistinctItem(GENERATOR_CLASS generator_class, int capacity, GeneratorRandom& random, SizeList& sizes)
+{
+    int tenth = fractionOf(capacity, 1, 10);
+    int two_fifths = fractionOf(capacity, 2, 5);
+    int half = fractionOf(capacity, 1, 2);
+
+    switch (generator_class)
+    {
+    case GENERATOR_CLASS::CAPRARA_TOTH_1:
+    case GENERATOR_CLASS::CAPRARA_TOTH_2:
+    case GENERATOR_CLASS::CAPRARA_TOTH_3:
+    case GENERATOR_CLASS::CAPRARA_TOTH_4:
+        {
+            int main_type = (int)generator_class - (int)GENERATOR_CLASS::CAPRARA_TOTH_1 + 1;
+            int r = random.uniformInt(1, 10);
+            int type = main_type;
+            if (r > 7)
+            {
+                // One of the 3 other types, with 10% each
+                type = r - 7;
+                if (type >= main_type)
+                {
+                    type += 1;
+                }
+            }
+            generateTypeSizes(type, capacity, random, sizes);
+        }
+        break;
+    case GENERATOR_CLASS::SPIEKSMA:
+        for (int& size : sizes)
+        {
+            size = random.uniformInt(tenth, two_fifths);
+        }
+        break;
+    case GENERATOR_CLASS::CORRELATED:
+    case GENERATOR_CLASS::ANTI_CORRELATED:
+        {
+            int base = random.uniformInt(tenth, two_fifths);
+            for (int h = 0; h < (int)sizes.size(); ++h)
+            {
+                int value = base;
+                if ((generator_class == GENERATOR_CLASS::ANTI_CORRELATED) && (h % 2 == 1))
+                {
+                    value = half - base; // Large in even dimensions means small in odd ones
+                }
+                value += random.uniformInt(-tenth, tenth);
+                sizes[h] = std::min(std::max(value, 1), capacity);
+            }
+        }
+        break;
+    }
+}
+
+std::vector<SizeList> generateItemSizes(const GeneratorParams& params)
+{
+    auto it = map_str_to_generator_class.find(params.class_name);
+    if (it == map_str_to_generator_class.end())
+    {
+        std::string s = "Unknown instance class " + params.class_name;
+        throw std::runtime_error(s);
+    }
+    if ((params.nb_items < 0) || (params.dimensions <= 0) || (params.capacity <= 0) || (params.max_multiplicity <= 0))
+    {
+        std::string s = "Invalid parameters for instance " + generatedInstanceName(params);
+        throw std::runtime_error(s);
+    }
+
+    GeneratorRandom random(params.seed);
+    std::vector<SizeList> item_sizes;
+    item_sizes.reserve(params.nb_items);
+    SizeList sizes(params.dimensions);
+    while ((int)item_sizes.size() < params.nb_items)
+    {
+        generateDistinctItem(it->second, params.capacity, random, sizes);
+
+        // The last item may have fewer copies to get exactly nb_items
+        int multiplicity = random.uniformInt(1, params.max_multiplicity);
+        multiplicity = std::min(multiplicity, params.nb_items - (int)item_sizes.size());
+        for (int i = 0; i < multiplicity; ++i)
+        {
+            item_sizes.push_back(sizes);
+        }
+    }
+    return item_sizes;
+}
+
+std::string generatedInstanceName(const GeneratorParams& params)
+{
+    return params.class_name
+        + "-n" + std::to_string(params.nb_items)
+        + "-d" + std::to_string(params.dimensions)
+        + "-c" + std::to_string(params.capacity)
+        + "-m" + std::to_string(params.max_multiplicity)
+        + "-s" + std::to_string(params.seed);
+}
+
+Instance* generateInstance(const GeneratorParams& params, const bool shuffle_items)
+{
+    std::vector<SizeList> item_sizes = generateItemSizes(params);
+    return new Instance(generatedInstanceName(params), SizeList(params.dimensions, params.capacity),
+                        item_sizes, shuffle_items);
+}
+
+void writeInstanceVbp(std::ostream& output, const SizeList& capacities, const std::vector<SizeList>& item_sizes)
+{
+    output << capacities.size() << "\n";
+    for (size_t h = 0; h < capacities.size(); ++h)
+    {
+        output << (h == 0 ? "" : " ") << capacities[h];
+    }
+    output << "\n" << item_sizes.size() << "\n";
+
+    std::string line;
+    for (const SizeList& sizes : item_sizes)
+    {
+        line.clear();
+        for (size_t h = 0; h < sizes.size(); ++h)
+        {
+            if (h > 0)
+            {
+                line += ' ';
+            }
+            line += std::to_string(sizes[h]);
+        }
+        line += '\n';
+        output << line;
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef INSTANCE_GENERATOR_HPP
+#define INSTANCE_GENERATOR_HPP
+
+#include <instance.hpp>
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace vectorpack;
+
+// Classes of synthetic instances, generalized to any number of dimensions
+// and expressed as fractions of the bin capacity C
+enum class GENERATOR_CLASS {
+     CAPRARA_TOTH_1 // Mixtures of Caprara and Toth (after Martello and Vigo), with 70% of items of type k
+    ,CAPRARA_TOTH_2 // and 10% of each other type. Type 1: large in even dimensions, small in odd ones;
+    ,CAPRARA_TOTH_3 // type 2: the opposite; type 3: large in all dimensions; type 4: small in all dimensions
+    ,CAPRARA_TOTH_4 // (large in [C/2, C], or [2C/3, C] for types 1 and 2; small in [1, C/2])
+    ,SPIEKSMA       // Sizes independently uniform in [C/10, 2C/5]
+    ,CORRELATED     // From Panigrahy et al. 2011: a base size uniform in [C/10, 2C/5] plus a noise of C/10 at most in each dimension
+    ,ANTI_CORRELATED // Same as CORRELATED, but the base size is mirrored (C/2 - base) in odd dimensions
+};
+
+const static std::map<std::string, GENERATOR_CLASS> map_str_to_generator_class = {
+    { "CT1", GENERATOR_CLASS::CAPRARA_TOTH_1 },
+    { "CT2", GENERATOR_CLASS::CAPRARA_TOTH_2 },
+    { "CT3", GENERATOR_CLASS::CAPRARA_TOTH_3 },
+    { "CT4", GENERATOR_CLASS::CAPRARA_TOTH_4 },
+    { "Spieksma", GENERATOR_CLASS::SPIEKSMA },
+    { "Correlated", GENERATOR_CLASS::CORRELATED },
+    { "AntiCorrelated", GENERATOR_CLASS::ANTI_CORRELATED },
+};
+
+struct GeneratorParams
+{
+    std::string class_name; // A key of map_str_to_generator_class
+    int nb_items;           // Total number of items, including copies
+    int dimensions;
+    int capacity;           // Bin capacity, the same in all dimensions
+    uint64_t seed;
+    int max_multiplicity;   // Each distinct item is repeated between 1 and max_multiplicity times
+};
+
+// Deterministic random generator (SplitMix64)
+// Standard distributions are implementation-defined, so the same seed
+// would not give the same instance with all standard libraries
+class GeneratorRandom
+{
+public:
+    GeneratorRandom(uint64_t seed);
+
+    uint64_t next();
+    int uniformInt(int min, int max); // In [min, max]
+
+protected:
+    uint64_t state;
+};
+
+// The size lists of the items of an instance, checked against the parameters
+std::vector<SizeList> generateItemSizes(const GeneratorParams& params);
+
+// Name of the generated instance, built from its parameters
+std::string generatedInstanceName(const GeneratorParams& params);
+
+// Generate a new instance in memory, owned by the caller
+Instance* generateInstance(const GeneratorParams& params, const bool shuffle_items = true);
+
+// Write an instance in the .vbp format read by Instance:
+// the number of dimensions, the bin capacities, the number of items, then the sizes of one item per line
+// Copies of the same item are written on separate lines, as the format has no demand column
+void writeInstanceVbp(std::ostream& output, const SizeList& capacities, const std::vector<SizeList>& item_sizes);
+
+#endif // INSTANCE_GENERATOR_HPP
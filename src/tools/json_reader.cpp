@@ -0,0 +1,293 @@
+#include "json_reader.hpp"
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+// Recursive descent parser over the whole text
+class JsonValue::Parser
+{
+public:
+    Parser(const std::string& text):
+        text(text),
+        pos(0)
+    { }
+
+    JsonValue parseDocument()
+    {
+        JsonValue value = parseValue();
+        skipSpaces();
+        if (pos != text.size())
+        {
+            fail("unexpected characters after the end of the document");
+        }
+        return value;
+    }
+
+protected:
+    void fail(const std::string& message) const
+    {
+        std::string s = "JSON error at position " + std::to_string(pos) + ": " + message;
+        throw std::runtime_error(s);
+    }
+
+    void skipSpaces()
+    {
+        while ((pos < text.size()) && std::isspace((unsigned char)text[pos]))
+        {
+            pos++;
+        }
+    }
+
+    void expect(char c)
+    {
+        skipSpaces();
+        if ((pos >= text.size()) || (text[pos] != c))
+        {
+            fail(std::string("expected '") + c + "'");
+        }
+        pos++;
+    }
+
+    bool consumeWord(const std::string& word)
+    {
+        if (text.compare(pos, word.size(), word) == 0)
+        {
+            pos += word.size();
+            return true;
+        }
+        return false;
+    }
+
+    JsonValue parseValue()
+    {
+        skipSpaces();
+        if (pos >= text.size())
+        {
+            fail("unexpected end of the document");
+        }
+
+        JsonValue value;
+        char c = text[pos];
+        if (c == '{')
+        {
+            value.type = TYPE::OBJECT;
+            pos++;
+            skipSpaces();
+            if ((pos < text.size()) && (text[pos] == '}'))
+            {
+                pos++;
+                return value;
+            }
+            while (true)
+            {
+                skipSpaces();
+                std::string key = parseString();
+                expect(':');
+                value.object_value[key] = parseValue();
+                skipSpaces();
+                if ((pos < text.size()) && (text[pos] == ','))
+                {
+                    pos++;
+                    continue;
+                }
+                expect('}');
+                return value;
+            }
+        }
+        else if (c == '[')
+        {
+            value.type = TYPE::ARRAY;
+            pos++;
+            skipSpaces();
+            if ((pos < text.size()) && (text[pos] == ']'))
+            {
+                pos++;
+                return value;
+            }
+            while (true)
+            {
+                value.array_value.push_back(parseValue());
+                skipSpaces();
+                if ((pos < text.size()) && (text[pos] == ','))
+                {
+                    pos++;
+                    continue;
+                }
+                expect(']');
+                return value;
+            }
+        }
+        else if (c == '"')
+        {
+            value.type = TYPE::STRING;
+            value.string_value = parseString();
+        }
+        else if (consumeWord("true"))
+        {
+            value.type = TYPE::BOOLEAN;
+            value.bool_value = true;
+        }
+        else if (consumeWord("false"))
+        {
+            value.type = TYPE::BOOLEAN;
+            value.bool_value = false;
+        }
+        else if (consumeWord("null"))
+        {
+            value.type = TYPE::NUL;
+        }
+        else
+        {
+            const char* start = text.c_str() + pos;
+            char* end = nullptr;
+            value.number_value = std::strtod(start, &end);
+            if (end == start)
+            {
+                fail("invalid value");
+            }
+            value.type = TYPE::NUMBER;
+            pos += end - start;
+        }
+        return value;
+    }
+
+    std::string parseString()
+    {
+        if ((pos >= text.size()) || (text[pos] != '"'))
+        {
+            fail("expected a string");
+        }
+        pos++;
+
+        std::string s;
+        while (pos < text.size())
+        {
+            char c = text[pos++];
+            if (c == '"')
+            {
+                return s;
+            }
+            if (c != '\\')
+            {
+                s += c;
+                continue;
+            }
+            if (pos >= text.size())
+            {
+                break;
+            }
+            char escaped = text[pos++];
+            switch (escaped)
+            {
+            case 'n': s += '\n'; break;
+            case 't': s += '\t'; break;
+            case 'r': s += '\r'; break;
+            case 'b': s += '\b'; break;
+            case 'f': s += '\f'; break;
+            case '"':
+            case '\\':
+            case '/': s += escaped; break;
+            default: fail("unsupported escape sequence");
+            }
+        }
+        fail("unterminated string");
+        return s;
+    }
+
+    const std::string& text;
+    size_t pos;
+};
+
+
+JsonValue::JsonValue():
+    type(TYPE::NUL),
+    bool_value(false),
+    number_value(0.0)
+{ }
+
+JsonValue::TYPE JsonValue::getType() const
+{
+    return type;
+}
+
+bool JsonValue::isNull() const
+{
+    return type == TYPE::NUL;
+}
+
+static void checkType(bool valid, const std::string& expected)
+{
+    if (!valid)
+    {
+        std::string s = "JSON value is not of type " + expected;
+        throw std::runtime_error(s);
+    }
+}
+
+bool JsonValue::asBool() const
+{
+    checkType(type == TYPE::BOOLEAN, "boolean");
+    return bool_value;
+}
+
+double JsonValue::asNumber() const
+{
+    checkType(type == TYPE::NUMBER, "number");
+    return number_value;
+}
+
+const std::string& JsonValue::asString() const
+{
+    checkType(type == TYPE::STRING, "string");
+    return string_value;
+}
+
+const std::vector<JsonValue>& JsonValue::asArray() const
+{
+    checkType(type == TYPE::ARRAY, "array");
+    return array_value;
+}
+
+const std::map<std::string, JsonValue>& JsonValue::asObject() const
+{
+    checkType(type == TYPE::OBJECT, "object");
+    return object_value;
+}
+
+bool JsonValue::has(const std::string& key) const
+{
+    return asObject().count(key) > 0;
+}
+
+const JsonValue& JsonValue::get(const std::string& key) const
+{
+    auto it = asObject().find(key);
+    if (it == object_value.end())
+    {
+        std::string s = "Missing JSON key " + key;
+        throw std::runtime_error(s);
+    }
+    return it->second;
+}
+
+JsonValue JsonValue::parse(const std::string& text)
+{
+    Parser parser(text);
+    return parser.parseDocument();
+}
+
+JsonValue JsonValue::parseFile(const std::string& filename)
+{
+    std::ifstream ifile(filename.c_str());
+    if (!ifile.is_open())
+    {
+        std::string s = "Could not open JSON file " + filename;
+        throw std::runtime_error(s);
+    }
+    std::stringstream buffer;
+    buffer << ifile.rdbuf();
+    return parse(buffer.str());
+}
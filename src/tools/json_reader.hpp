@@ -0,0 +1,45 @@
+#ifndef JSON_READER_HPP
+#define JSON_READER_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Minimal JSON reader, enough to read back the results written by the tools
+// Numbers are stored as double, and strings only support the simple escapes (no \u)
+class JsonValue
+{
+public:
+    enum class TYPE { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+    JsonValue();
+
+    TYPE getType() const;
+    bool isNull() const;
+
+    // These methods throw when the value has another type
+    bool asBool() const;
+    double asNumber() const;
+    const std::string& asString() const;
+    const std::vector<JsonValue>& asArray() const;
+    const std::map<std::string, JsonValue>& asObject() const;
+
+    // For objects only
+    bool has(const std::string& key) const;
+    const JsonValue& get(const std::string& key) const; // Throws if the key is missing
+
+    static JsonValue parse(const std::string& text);
+    static JsonValue parseFile(const std::string& filename);
+
+protected:
+    class Parser;
+
+    TYPE type;
+    bool bool_value;
+    double number_value;
+    std::string string_value;
+    std::vector<JsonValue> array_value;
+    std::map<std::string, JsonValue> object_value;
+};
+
+#endif // JSON_READER_HPP
@@ -0,0 +1,510 @@
+#include <algos_ItemCentric.hpp>
+#include <algos_BinCentric.hpp>
+#include <lower_bounds.hpp>
+#include <algo_stats.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace vectorpack;
+
+/*
+ * Microbenchmarks of the core kernels of the library:
+ *  - Bin::doesItemFit and Bin::addItem
+ *  - the item-bin score of each SCORE (AlgoBinCentric::computeItemBinScore)
+ *  - the item measure of each MEASURE (AlgoFFD::computeItemMeasures)
+ *  - the sorts and bubble rounds on items and bins
+ *  - the clique lower bounds LB_clique and LB_clique_implicit
+ * Each kernel is run on random instances for all pairs of dimensions and number of items
+ * Results are written in JSON: minimum and median time per operation over several runs
+ */
+
+static const int BENCH_CAPACITY = 1000; // Bin capacity in every dimension
+static const std::string BENCH_ALGO_NAME = "bench"; // Algorithms keep a reference on their name
+
+// Sink for the results of the kernels, so that the compiler does not optimize them away
+static volatile double bench_sink = 0.0;
+
+struct BenchConfig
+{
+    std::vector<int> dimensions = {1, 2, 4, 8, 16, 64};
+    std::vector<int> nb_items = {1000, 10000, 100000, 1000000};
+    long max_cells = 4000000;    // Pairs (d, n) with n*d above this value are skipped (memory)
+    int max_clique_items = 4000; // LB_clique is quadratic in the number of items
+    int min_runs = 5;
+    double min_time_ms = 100.0;  // Minimum total measured time of each benchmark
+    std::string filter;          // Only run kernels whose name contains this string
+    unsigned int seed = 42;
+};
+
+struct BenchResult
+{
+    std::string kernel;
+    std::string variant;
+    int dimensions;
+    int nb_items;
+    long ops_per_run;
+    int runs;
+    double min_ns_per_op;
+    double median_ns_per_op;
+};
+
+
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+// Probes giving access to the protected kernels of the algorithms
+class ProbeBinCentric : public AlgoBinCentric
+{
+public:
+    ProbeBinCentric(const Instance& instance, const SCORE score):
+        AlgoBinCentric(BENCH_ALGO_NAME, instance, score, WEIGHT::AVERAGE, false, false)
+    {
+        utilComputeWeights(weight, dimensions, items.size(), weights_list, total_norm_size);
+    }
+
+    using AlgoBinCentric::createNewBin;
+    using AlgoBinCentric::addItemToBin;
+    using AlgoBinCentric::computeItemBinScore;
+};
+
+class ProbeFFD : public AlgoFFD
+{
+public:
+    ProbeFFD(const Instance& instance, const MEASURE measure):
+        AlgoFFD(BENCH_ALGO_NAME, instance, measure, WEIGHT::AVERAGE, false)
+    { }
+
+    using AlgoFFD::computeItemMeasures;
+    using AlgoFFD::sortItems;
+    using BaseAlgo::items;
+};
+
+
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+// Run setup (not measured) then run (measured) until both min_runs and min_time_ms are reached
+template <class Setup, class Run>
+BenchResult runBenchmark(const BenchConfig& config, const std::string& kernel, const std::string& variant,
+                         int dimensions, int nb_items, long ops_per_run, Setup setup, Run run)
+{
+    std::vector<double> run_times; // In nanoseconds
+    double total_ms = 0.0;
+    while (((int)run_times.size() < config.min_runs) || (total_ms < config.min_time_ms))
+    {
+        setup();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        run();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        run_times.push_back(elapsed.count());
+        total_ms += elapsed.count() / 1e6;
+    }
+
+    std::sort(run_times.begin(), run_times.end());
+    double ops = std::max(ops_per_run, 1L);
+    BenchResult result = {kernel, variant, dimensions, nb_items, ops_per_run, (int)run_times.size(),
+                          run_times.front() / ops, run_times[run_times.size() / 2] / ops};
+    std::cerr << kernel << (variant.empty() ? "" : "/" + variant)
+              << " d=" << dimensions << " n=" << nb_items << ": "
+              << std::fixed << std::setprecision(3) << result.median_ns_per_op << " ns/op" << std::endl;
+    return result;
+}
+
+bool isSelected(const BenchConfig& config, const std::string& kernel)
+{
+    return config.filter.empty() || (kernel.find(config.filter) != std::string::npos);
+}
+
+// Random instance with sizes uniformly drawn in [1, 3/5 of the capacity]
+// so that some pairs of items are incompatible
+Instance* generateBenchInstance(int dimensions, int nb_items, unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> size_distribution(1, 3 * BENCH_CAPACITY / 5);
+
+    std::vector<SizeList> item_sizes(nb_items, SizeList(dimensions));
+    for (SizeList& sizes : item_sizes)
+    {
+        for (int& size : sizes)
+        {
+            size = size_distribution(generator);
+        }
+    }
+    std::string name = "bench-d" + std::to_string(dimensions) + "-n" + std::to_string(nb_items);
+    return new Instance(name, SizeList(dimensions, BENCH_CAPACITY), item_sizes, false);
+}
+
+// Add items to the bin until it is at least half full in the first dimension
+void halfFillBin(Bin* bin, const ItemList& items)
+{
+    for (Item* item : items)
+    {
+        if (bin->getAvailableCapDim(0) <= BENCH_CAPACITY / 2)
+        {
+            break;
+        }
+        if (bin->doesItemFit(item->getSizes()))
+        {
+            bin->addItem(item);
+        }
+    }
+}
+
+
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+void benchBin(const BenchConfig& config, const Instance& instance, std::vector<BenchResult>& results)
+{
+    const ItemList& items = instance.getItems();
+    int d = instance.getDimensions();
+    int n = instance.getNbItems();
+
+    if (isSelected(config, "Bin::doesItemFit"))
+    {
+        Bin bin(0, instance.getBinCapacities());
+        halfFillBin(&bin, items);
+        results.push_back(runBenchmark(config, "Bin::doesItemFit", "", d, n, n,
+            []() { },
+            [&]() {
+                int nb_fit = 0;
+                for (Item* item : items)
+                {
+                    nb_fit += bin.doesItemFit(item->getSizes());
+                }
+                bench_sink = bench_sink + nb_fit;
+            }));
+    }
+
+    if (isSelected(config, "Bin::addItem"))
+    {
+        // Large enough for all items
+        SizeList capacities(d, BENCH_CAPACITY * n);
+        Bin bin(0, capacities);
+        results.push_back(runBenchmark(config, "Bin::addItem", "", d, n, n,
+            [&]() { bin.reset(); },
+            [&]() {
+                for (Item* item : items)
+                {
+                    bin.addItem(item);
+                }
+                bench_sink = bench_sink + bin.getAvailableCapDim(0);
+            }));
+    }
+}
+
+void benchScores(const BenchConfig& config, const Instance& instance, std::vector<BenchResult>& results)
+{
+    if (!isSelected(config, "computeItemBinScore"))
+    {
+        return;
+    }
+
+    int d = instance.getDimensions();
+    int n = instance.getNbItems();
+    for (const auto& score_pair : map_str_to_score)
+    {
+        ProbeBinCentric algo(instance, score_pair.second);
+        Bin* bin = algo.createNewBin();
+        for (Item* item : instance.getItems())
+        {
+            if (bin->getAvailableCapDim(0) <= BENCH_CAPACITY / 2)
+            {
+                break;
+            }
+            if (bin->doesItemFit(item->getSizes()))
+            {
+                algo.addItemToBin(item, bin);
+            }
+        }
+
+        results.push_back(runBenchmark(config, "computeItemBinScore", score_pair.first, d, n, n,
+            []() { },
+            [&]() {
+                float total = 0.0;
+                for (Item* item : instance.getItems())
+                {
+                    total += algo.computeItemBinScore(item, bin);
+                }
+                bench_sink = bench_sink + total;
+            }));
+    }
+}
+
+void benchMeasures(const BenchConfig& config, const Instance& instance, std::vector<BenchResult>& results)
+{
+    if (!isSelected(config, "computeItemMeasures"))
+    {
+        return;
+    }
+
+    int d = instance.getDimensions();
+    int n = instance.getNbItems();
+    for (const auto& measure_pair : map_str_to_measure)
+    {
+        ProbeFFD algo(instance, measure_pair.second);
+        results.push_back(runBenchmark(config, "computeItemMeasures", measure_pair.first, d, n, n,
+            []() { },
+            [&]() { algo.computeItemMeasures(algo.items.begin(), algo.items.end()); }));
+    }
+}
+
+void benchSorts(const BenchConfig& config, const Instance& instance, std::vector<BenchResult>& results)
+{
+    int d = instance.getDimensions();
+    int n = instance.getNbItems();
+    const ItemList& initial_items = instance.getItems();
+
+    if (isSelected(config, "sortItems"))
+    {
+        ProbeFFD algo(instance, MEASURE::L2);
+        algo.computeItemMeasures(algo.items.begin(), algo.items.end());
+        results.push_back(runBenchmark(config, "sortItems", "measure", d, n, n,
+            [&]() { algo.items = initial_items; },
+            [&]() { algo.sortItems(algo.items.begin(), algo.items.end()); }));
+
+        ItemList items;
+        results.push_back(runBenchmark(config, "sortItems", "lexicographic", d, n, n,
+            [&]() { items = initial_items; },
+            [&]() { std::stable_sort(items.begin(), items.end(), item_comparator_lexicographic_decreasing); }));
+    }
+
+    if (isSelected(config, "sortBins") || isSelected(config, "bubbleBins"))
+    {
+        // About one bin for 4 items, with random measures
+        int nb_bins = std::max(n / 4, 1);
+        std::mt19937 generator(config.seed);
+        std::uniform_real_distribution<float> measure_distribution(0.0, 1.0);
+        BinList initial_bins;
+        FloatList initial_measures;
+        for (int i = 0; i < nb_bins; ++i)
+        {
+            initial_bins.push_back(new Bin(i, instance.getBinCapacities()));
+            initial_measures.push_back(measure_distribution(generator));
+        }
+
+        BinList bins;
+        auto reset_bins = [&]() {
+            bins = initial_bins;
+            for (int i = 0; i < nb_bins; ++i)
+            {
+                bins[i]->setMeasure(initial_measures[i]);
+            }
+        };
+
+        if (isSelected(config, "sortBins"))
+        {
+            results.push_back(runBenchmark(config, "sortBins", "measure", d, n, nb_bins,
+                reset_bins,
+                [&]() { std::stable_sort(bins.begin(), bins.end(), bin_comparator_measure_increasing); }));
+        }
+
+        if (isSelected(config, "bubbleBins"))
+        {
+            // As in best fit algorithms: the bins are sorted, and only one bin has changed
+            std::stable_sort(initial_bins.begin(), initial_bins.end(), bin_comparator_measure_increasing);
+            std::sort(initial_measures.begin(), initial_measures.end());
+            initial_measures.back() = -1.0;
+            results.push_back(runBenchmark(config, "bubbleBins", "up", d, n, nb_bins,
+                reset_bins,
+                [&]() { bench_sink = bench_sink + bubble_bin_up(bins.begin(), bins.end(), bin_comparator_measure_increasing); }));
+        }
+
+        for (Bin* bin : initial_bins)
+        {
+            delete bin;
+        }
+    }
+}
+
+void benchLowerBounds(const BenchConfig& config, const Instance& instance, std::vector<BenchResult>& results)
+{
+    int d = instance.getDimensions();
+    int n = instance.getNbItems();
+    if (isSelected(config, "LB_clique") && (n <= config.max_clique_items))
+    {
+        results.push_back(runBenchmark(config, "LB_clique", "", d, n, n,
+            []() { },
+            [&]() { bench_sink = bench_sink + LB_clique(instance); }));
+    }
+    if (isSelected(config, "LB_clique_implicit"))
+    {
+        results.push_back(runBenchmark(config, "LB_clique_implicit", "", d, n, n,
+            []() { },
+            [&]() { bench_sink = bench_sink + LB_clique_implicit(instance); }));
+    }
+}
+
+
+/* ================================================ */
+/* ================================================ */
+/* ================================================ */
+std::string formatResults(const BenchConfig& config, const std::vector<BenchResult>& results)
+{
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "{\n  \"counters_enabled\": " << (AlgoStats::isEnabled() ? "true" : "false")
+       << ",\n  \"seed\": " << config.seed
+       << ",\n  \"min_runs\": " << config.min_runs
+       << ",\n  \"min_time_ms\": " << config.min_time_ms
+       << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchResult& result = results[i];
+        ss << (i == 0 ? "\n" : ",\n")
+           << "    {\"kernel\": \"" << result.kernel << "\""
+           << ", \"variant\": \"" << result.variant << "\""
+           << ", \"d\": " << result.dimensions
+           << ", \"n\": " << result.nb_items
+           << ", \"ops_per_run\": " << result.ops_per_run
+           << ", \"runs\": " << result.runs
+           << ", \"min_ns_per_op\": " << result.min_ns_per_op
+           << ", \"median_ns_per_op\": " << result.median_ns_per_op << "}";
+    }
+    ss << "\n  ]\n}\n";
+    return ss.str();
+}
+
+std::vector<int> parseIntList(const std::string& str)
+{
+    std::vector<int> values;
+    std::istringstream values_stream(str);
+    std::string value;
+    while (std::getline(values_stream, value, ','))
+    {
+        if (!value.empty())
+        {
+            values.push_back(std::stoi(value));
+        }
+    }
+    return values;
+}
+
+void show_usage(std::string prog_name)
+{
+    std::cerr << "Usage: " << prog_name << " [<option(s)>]\n"
+              << "Options:\n"
+              << "\t-h, --help: Shows this help message\n"
+              << "\t-o <filename>, --output <filename>: Writes the JSON results into <filename> instead of stdout\n"
+              << "\t--dims <list>: Comma-separated list of dimensions (default: 1,2,4,8,16,64)\n"
+              << "\t--items <list>: Comma-separated list of number of items (default: 1000,10000,100000,1000000)\n"
+              << "\t--max-cells <n>: Skips instances with more than <n> item sizes, i.e. n*d (default: 4000000)\n"
+              << "\t--max-clique-items <n>: Maximum number of items for LB_clique (default: 4000)\n"
+              << "\t--min-runs <n>: Minimum number of measured runs of each benchmark (default: 5)\n"
+              << "\t--min-time <ms>: Minimum total measured time of each benchmark (default: 100)\n"
+              << "\t--filter <str>: Only runs the kernels whose name contains <str>\n"
+              << "\t--seed <n>: Seed of the random instances (default: 42)\n"
+              << "Progress is reported on stderr"
+              << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    BenchConfig config;
+    std::string output_file;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if ((arg == "-h") || (arg == "--help"))
+        {
+            show_usage(argv[0]);
+            return 0;
+        }
+        if (i+1 >= argc)
+        {
+            std::cerr << "Unknow option or missing value: " << arg << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+        if ((arg == "-o") || (arg == "--output"))
+        {
+            output_file = value;
+        }
+        else if (arg == "--dims")
+        {
+            config.dimensions = parseIntList(value);
+        }
+        else if (arg == "--items")
+        {
+            config.nb_items = parseIntList(value);
+        }
+        else if (arg == "--max-cells")
+        {
+            config.max_cells = std::stol(value);
+        }
+        else if (arg == "--max-clique-items")
+        {
+            config.max_clique_items = std::stoi(value);
+        }
+        else if (arg == "--min-runs")
+        {
+            config.min_runs = std::max(std::stoi(value), 1);
+        }
+        else if (arg == "--min-time")
+        {
+            config.min_time_ms = std::stod(value);
+        }
+        else if (arg == "--filter")
+        {
+            config.filter = value;
+        }
+        else if (arg == "--seed")
+        {
+            config.seed = std::stoul(value);
+        }
+        else
+        {
+            std::cerr << "Unknow option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    for (int d : config.dimensions)
+    {
+        for (int n : config.nb_items)
+        {
+            if ((d <= 0) || (n <= 0) || ((long)n * d > config.max_cells))
+            {
+                std::cerr << "Skipping d=" << d << " n=" << n << std::endl;
+                continue;
+            }
+
+            Instance* instance = generateBenchInstance(d, n, config.seed);
+            benchBin(config, *instance, results);
+            benchScores(config, *instance, results);
+            benchMeasures(config, *instance, results);
+            benchSorts(config, *instance, results);
+            benchLowerBounds(config, *instance, results);
+            delete instance;
+        }
+    }
+
+    std::string json = formatResults(config, results);
+    if (output_file.empty())
+    {
+        std::cout << json;
+    }
+    else
+    {
+        std::ofstream f(output_file, std::ios_base::trunc);
+        if (!f.is_open())
+        {
+            std::cerr << "Cannot write results to file " << output_file << std::endl;
+            return 1;
+        }
+        f << json;
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "instance_generator.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+using namespace vectorpack;
+
+/*
+ * Generator of synthetic Vector Bin Packing instances
+ * Inputs:
+ *  - the instance class (see map_str_to_generator_class)
+ *  - the number of items and of dimensions
+ * Output:
+ *  - the instance in .vbp format, the same parameters always give the same instance
+ */
+
+void show_usage(std::string prog_name)
+{
+    std::cerr << "Usage: " << prog_name << " <class> <nb_items> <dimensions> [<option(s)>]\n"
+              << "Classes:";
+    for (const auto& class_pair : map_str_to_generator_class)
+    {
+        std::cerr << " " << class_pair.first;
+    }
+    std::cerr << "\nOptions:\n"
+              << "\t-h, --help: Shows this help message\n"
+              << "\t-o <filename>, --output <filename>: Writes the instance into <filename> instead of stdout\n"
+              << "\t-c <n>, --capacity <n>: Bin capacity in all dimensions (default: 1000)\n"
+              << "\t-s <n>, --seed <n>: Seed of the random generator (default: 1)\n"
+              << "\t-m <n>, --multiplicity <n>: Each distinct item is repeated between 1 and <n> times (default: 1)\n"
+              << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        show_usage(argv[0]);
+        return 1;
+    }
+
+    GeneratorParams params;
+    params.class_name = argv[1];
+    params.nb_items = std::stoi(argv[2]);
+    params.dimensions = std::stoi(argv[3]);
+    params.capacity = 1000;
+    params.seed = 1;
+    params.max_multiplicity = 1;
+    std::string output_file;
+
+    for (int i = 4; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if ((arg == "-h") || (arg == "--help"))
+        {
+            show_usage(argv[0]);
+            return 0;
+        }
+        if (i+1 >= argc)
+        {
+            std::cerr << "Unknow option or missing value: " << arg << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+        if ((arg == "-o") || (arg == "--output"))
+        {
+            output_file = value;
+        }
+        else if ((arg == "-c") || (arg == "--capacity"))
+        {
+            params.capacity = std::stoi(value);
+        }
+        else if ((arg == "-s") || (arg == "--seed"))
+        {
+            params.seed = std::stoull(value);
+        }
+        else if ((arg == "-m") || (arg == "--multiplicity"))
+        {
+            params.max_multiplicity = std::stoi(value);
+        }
+        else
+        {
+            std::cerr << "Unknow option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<SizeList> item_sizes = generateItemSizes(params);
+    SizeList capacities(params.dimensions, params.capacity);
+    if (output_file.empty())
+    {
+        writeInstanceVbp(std::cout, capacities, item_sizes);
+    }
+    else
+    {
+        std::ofstream f(output_file, std::ios_base::trunc);
+        if (!f.is_open())
+        {
+            std::string s("Cannot write instance to file " + output_file);
+            throw std::runtime_error(s);
+        }
+        writeInstanceVbp(f, capacities, item_sizes);
+    }
+    return 0;
+}
@@ -0,0 +1,443 @@
+#include "instance_generator.hpp"
+#include "json_reader.hpp"
+
+#include <algo_utils.hpp>
+#include <lower_bounds.hpp>
+#include <algo_stats.hpp>
+
+#include <sys/resource.h> // For getrusage
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace vectorpack;
+
+/*
+ * End-to-end performance regression harness
+ * A fixed matrix of algorithms is run on generated instances, and for each pair
+ * the number of bins, the solve time, the peak memory and the operation counters are recorded in JSON
+ * When a baseline (a previous JSON output) is given, the results are compared to it
+ * and the program exits with code 2 if a pair regresses in bins, time, memory or counters
+ * If a pair fails (e.g. unknown algorithm name), the results are not written, as they
+ * would make an invalid baseline, and the program exits with code 3
+ * A baseline where a pair failed is rejected
+ */
+
+// Instances of the matrix, with their number of items before scaling
+static const std::vector<GeneratorParams> DEFAULT_INSTANCES = {
+    { "CT1", 400, 2, 1000, 1, 1 },
+    { "CT4", 400, 2, 1000, 1, 1 },
+    { "Spieksma", 400, 4, 1000, 1, 1 },
+    { "Spieksma", 400, 3, 1000, 2, 4 },
+    { "Correlated", 400, 8, 1000, 1, 1 },
+    { "AntiCorrelated", 400, 2, 1000, 1, 1 },
+};
+
+// One algorithm of each family, including the ones with quadratic paths (T2, Rank, Pairing...)
+static const std::vector<std::string> DEFAULT_ALGOS = {
+    "FF",
+    "FFD-L2-Avg",
+    "FFD-L1-Avg-Dyn",
+    "BFD-T1-L2-Avg",
+    "BFD-T2-L2-Avg",
+    "BFD-T3-L2-Avg-ReciprocAvg",
+    "WFD-T2-Linf-Avg",
+    "BF-L2-Avg",
+    "FFD-Lexico",
+    "FFD-Rank",
+    "BFD-Rank-Dyn",
+    "BCS-DP1-Avg",
+    "BCS-NormDP-Avg",
+    "Pairing-BS-DP1-Avg",
+    "WFDm-BS-L2-Avg",
+    "BFDm-Incr-Linf-UtilRatio-5",
+};
+
+struct Tolerances
+{
+    double time = 0.25;       // Relative increase of the solve time
+    double min_time_ms = 1.0; // Absolute increase of the solve time below which it is considered noise
+    double rss = 0.25;        // Relative increase of the peak memory
+    double counters = 0.10;   // Relative increase of each operation counter
+    int bins = 0;             // Absolute increase of the number of bins
+};
+
+struct CaseResult
+{
+    std::string instance_name;
+    std::string algo_name;
+    int LB;
+    int bins;
+    double time_ms; // Minimum over the repetitions
+    long peak_rss_kb;
+    AlgoStats stats; // Of the last repetition
+    std::string error;
+};
+
+// Peak resident memory of the process, in kilobytes
+// It never decreases, so it is the peak of all cases run so far
+long getPeakRssKb()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // In bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+CaseResult runCase(const Instance& instance, const std::string& algo_name, int nb_repeat)
+{
+    CaseResult result = {instance.getName(), algo_name, -1, -1, 0.0, 0, AlgoStats(), ""};
+    try {
+        result.LB = LB_BPP(instance);
+        int UB = 0;
+        if (isMultiBinAlgo(algo_name))
+        {
+            UB = computeUpperBoundFF(instance, result.LB);
+        }
+
+        for (int run = 0; run < nb_repeat; ++run)
+        {
+            // Each run computes its item order again
+            instance.clearCachedItemOrders();
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            BaseAlgo* algo = createAlgo(algo_name, instance);
+            try {
+                result.bins = solveWithAlgo(algo, algo_name, result.LB, UB);
+            }
+            catch (std::exception& e)
+            {
+                delete algo;
+                throw;
+            }
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+            result.stats = algo->getStats();
+            delete algo;
+            if ((run == 0) || (elapsed.count() < result.time_ms))
+            {
+                result.time_ms = elapsed.count();
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        result.error = e.what();
+    }
+    result.peak_rss_kb = getPeakRssKb();
+    return result;
+}
+
+std::string jsonString(const std::string& str)
+{
+    std::string s = "\"";
+    for (char c : str)
+    {
+        if ((c == '"') || (c == '\\'))
+        {
+            s += '\\';
+        }
+        s += c;
+    }
+    return s + "\"";
+}
+
+std::string formatResults(const std::vector<CaseResult>& results, double scale, int nb_repeat)
+{
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "{\n  \"counters_enabled\": " << (AlgoStats::isEnabled() ? "true" : "false")
+       << ",\n  \"scale\": " << scale
+       << ",\n  \"repeat\": " << nb_repeat
+       << ",\n  \"peak_rss_kb\": " << getPeakRssKb()
+       << ",\n  \"cases\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const CaseResult& result = results[i];
+        ss << (i == 0 ? "\n" : ",\n")
+           << "    {\"instance\": " << jsonString(result.instance_name)
+           << ", \"algorithm\": " << jsonString(result.algo_name)
+           << ", \"LB\": " << result.LB
+           << ", \"bins\": " << result.bins
+           << ", \"time_ms\": " << result.time_ms
+           << ", \"peak_rss_kb\": " << result.peak_rss_kb
+           << ", \"counters\": " << result.stats.toJson()
+           << ", \"error\": " << jsonString(result.error) << "}";
+    }
+    ss << "\n  ]\n}\n";
+    return ss.str();
+}
+
+
+// Compare the results to the baseline, report regressions on stderr and return their number
+int compareToBaseline(const std::vector<CaseResult>& results, const JsonValue& baseline,
+                      const Tolerances& tolerances, double scale)
+{
+    int nb_regressions = 0;
+    auto report = [&nb_regressions](const std::string& kind, const std::string& case_name,
+                                    double value, double baseline_value) {
+        nb_regressions++;
+        std::cerr << "REGRESSION " << kind << " " << case_name << ": "
+                  << std::fixed << std::setprecision(3) << value << " vs " << baseline_value << " in baseline" << std::endl;
+    };
+
+    if (baseline.get("scale").asNumber() != scale)
+    {
+        std::cerr << "Warning: the baseline was run with another scale, times are not comparable" << std::endl;
+    }
+    bool compare_counters = AlgoStats::isEnabled() && baseline.get("counters_enabled").asBool();
+
+    for (const CaseResult& result : results)
+    {
+        std::string case_name = result.instance_name + " " + result.algo_name;
+        if (!result.error.empty())
+        {
+            nb_regressions++;
+            std::cerr << "REGRESSION error " << case_name << ": " << result.error << std::endl;
+            continue;
+        }
+
+        const JsonValue* base_case = nullptr;
+        for (const JsonValue& value : baseline.get("cases").asArray())
+        {
+            if ((value.get("instance").asString() == result.instance_name) && (value.get("algorithm").asString() == result.algo_name))
+            {
+                base_case = &value;
+                break;
+            }
+        }
+        if (base_case == nullptr)
+        {
+            std::cerr << "New case " << case_name << " (not in baseline)" << std::endl;
+            continue;
+        }
+
+        double base_bins = base_case->get("bins").asNumber();
+        // Multi-bin algorithms return -1 when no solution was found
+        bool lost_solution = (result.bins < 0) && (base_bins >= 0);
+        if (lost_solution || ((base_bins >= 0) && (result.bins > base_bins + tolerances.bins)))
+        {
+            report("bins", case_name, result.bins, base_bins);
+        }
+
+        double base_time = base_case->get("time_ms").asNumber();
+        if ((result.time_ms > base_time * (1.0 + tolerances.time)) && (result.time_ms - base_time > tolerances.min_time_ms))
+        {
+            report("time_ms", case_name, result.time_ms, base_time);
+        }
+
+        if (compare_counters)
+        {
+            // Counters are compared by name, through their JSON form
+            JsonValue counters = JsonValue::parse(result.stats.toJson());
+            const JsonValue& base_counters = base_case->get("counters");
+            for (const auto& counter : counters.asObject())
+            {
+                if (!base_counters.has(counter.first))
+                {
+                    continue;
+                }
+                double value = counter.second.asNumber();
+                double base_value = base_counters.get(counter.first).asNumber();
+                if ((value > base_value * (1.0 + tolerances.counters)) && (value > base_value))
+                {
+                    report(counter.first, case_name, value, base_value);
+                }
+            }
+        }
+    }
+
+    double peak_rss = getPeakRssKb();
+    double base_peak_rss = baseline.get("peak_rss_kb").asNumber();
+    if (peak_rss > base_peak_rss * (1.0 + tolerances.rss))
+    {
+        report("peak_rss_kb", "(all cases)", peak_rss, base_peak_rss);
+    }
+    return nb_regressions;
+}
+
+
+std::vector<std::string> parseList(const std::string& str)
+{
+    std::vector<std::string> values;
+    std::istringstream values_stream(str);
+    std::string value;
+    while (std::getline(values_stream, value, ','))
+    {
+        if (!value.empty())
+        {
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+
+void show_usage(std::string prog_name)
+{
+    std::cerr << "Usage: " << prog_name << " [<option(s)>]\n"
+              << "Options:\n"
+              << "\t-h, --help: Shows this help message\n"
+              << "\t-o <filename>, --output <filename>: Writes the JSON results into <filename> instead of stdout\n"
+              << "\t\tNothing is written if a pair failed, and the program exits with code 3\n"
+              << "\t-b <filename>, --baseline <filename>: Compares the results to a previous output, exits with code 2 on regression\n"
+              << "\t--algos <list>: Comma-separated list of algorithms replacing the default matrix ('all' or 'BCS-*' select several algorithms)\n"
+              << "\t--scale <f>: Multiplies the number of items of all instances (default: 1)\n"
+              << "\t--repeat <n>: Number of runs of each pair, the minimum time is kept (default: 3)\n"
+              << "\t--time-tolerance <f>: Allowed relative increase of the solve time (default: 0.25)\n"
+              << "\t--min-time <ms>: Increases of the solve time below this value are ignored (default: 1)\n"
+              << "\t--rss-tolerance <f>: Allowed relative increase of the peak memory (default: 0.25)\n"
+              << "\t--counter-tolerance <f>: Allowed relative increase of each operation counter (default: 0.1)\n"
+              << "\t--bins-tolerance <n>: Allowed increase of the number of bins (default: 0)\n"
+              << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    std::string output_file;
+    std::string baseline_file;
+    std::vector<std::string> algo_names = DEFAULT_ALGOS;
+    double scale = 1.0;
+    int nb_repeat = 3;
+    Tolerances tolerances;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if ((arg == "-h") || (arg == "--help"))
+        {
+            show_usage(argv[0]);
+            return 0;
+        }
+        if (i+1 >= argc)
+        {
+            std::cerr << "Unknow option or missing value: " << arg << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+        if ((arg == "-o") || (arg == "--output"))
+        {
+            output_file = value;
+        }
+        else if ((arg == "-b") || (arg == "--baseline"))
+        {
+            baseline_file = value;
+        }
+        else if (arg == "--algos")
+        {
+            algo_names = expandAlgoNames(parseList(value));
+        }
+        else if (arg == "--scale")
+        {
+            scale = std::stod(value);
+        }
+        else if (arg == "--repeat")
+        {
+            nb_repeat = std::max(std::stoi(value), 1);
+        }
+        else if (arg == "--time-tolerance")
+        {
+            tolerances.time = std::stod(value);
+        }
+        else if (arg == "--min-time")
+        {
+            tolerances.min_time_ms = std::stod(value);
+        }
+        else if (arg == "--rss-tolerance")
+        {
+            tolerances.rss = std::stod(value);
+        }
+        else if (arg == "--counter-tolerance")
+        {
+            tolerances.counters = std::stod(value);
+        }
+        else if (arg == "--bins-tolerance")
+        {
+            tolerances.bins = std::stoi(value);
+        }
+        else
+        {
+            std::cerr << "Unknow option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    // Read the baseline first, to fail early
+    JsonValue baseline;
+    if (!baseline_file.empty())
+    {
+        baseline = JsonValue::parseFile(baseline_file);
+        for (const JsonValue& value : baseline.get("cases").asArray())
+        {
+            if (!value.get("error").asString().empty())
+            {
+                std::cerr << "Invalid baseline " << baseline_file << ", a pair failed: " << value.get("instance").asString()
+                          << " " << value.get("algorithm").asString() << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::vector<CaseResult> results;
+    int nb_errors = 0;
+    for (GeneratorParams params : DEFAULT_INSTANCES)
+    {
+        params.nb_items = std::max(1, (int)(params.nb_items * scale));
+        Instance* instance = generateInstance(params);
+        for (const std::string& algo_name : algo_names)
+        {
+            results.push_back(runCase(*instance, algo_name, nb_repeat));
+            const CaseResult& result = results.back();
+            std::cerr << result.instance_name << " " << result.algo_name << ": " << result.bins << " bins, "
+                      << std::fixed << std::setprecision(3) << result.time_ms << " ms"
+                      << (result.error.empty() ? "" : " (" + result.error + ")") << std::endl;
+            nb_errors += !result.error.empty();
+        }
+        delete instance;
+    }
+
+    std::string json = formatResults(results, scale, nb_repeat);
+    if (nb_errors > 0)
+    {
+        std::cerr << nb_errors << " pair(s) failed, the results are not written" << std::endl;
+    }
+    else if (output_file.empty())
+    {
+        std::cout << json;
+    }
+    else
+    {
+        std::ofstream f(output_file, std::ios_base::trunc);
+        if (!f.is_open())
+        {
+            std::cerr << "Cannot write results to file " << output_file << std::endl;
+            return 1;
+        }
+        f << json;
+    }
+
+    if (!baseline_file.empty())
+    {
+        int nb_regressions = compareToBaseline(results, baseline, tolerances, scale);
+        if (nb_regressions > 0)
+        {
+            std::cerr << nb_regressions << " regression(s) found against " << baseline_file << std::endl;
+            return (nb_errors > 0) ? 3 : 2;
+        }
+        std::cerr << "No regression found against " << baseline_file << std::endl;
+    }
+    return (nb_errors > 0) ? 3 : 0;
+}